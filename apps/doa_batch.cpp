@@ -0,0 +1,102 @@
+#include <batch_localizer.hpp>
+#include <decoder.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <boost/program_options.hpp>
+
+using namespace score;
+namespace po = boost::program_options;
+
+static ArrayGeometry MakeGeometry(const std::string& name, std::int32_t channels, double spacing) {
+    if (name == "respeaker4") {
+        return ArrayGeometry::ReSpeaker4Mic();
+    } else if (name == "respeaker6") {
+        return ArrayGeometry::ReSpeaker6Mic();
+    } else if (name == "linear") {
+        return ArrayGeometry::Linear(static_cast<std::size_t>(channels), spacing);
+    } else if (name == "circular") {
+        return ArrayGeometry::Circular(static_cast<std::size_t>(channels), spacing / 2);
+    }
+    throw std::invalid_argument("Unknown geometry: " + name);
+}
+
+int main(int ac, char* av[]) {
+    std::string input, output, geometry_name;
+    std::size_t duration, chunk, threads;
+    double spacing;
+    bool csv;
+
+    po::options_description desc("Batch DOA options");
+    desc.add_options()
+            ("help, h", "Help message")
+            ("input, i", po::value<std::string>(&input)->required(), "Multi-channel audio file to analyse.")
+            ("output, o", po::value<std::string>(&output)->required(), "File storing the per-frame results.")
+            ("geometry, g", po::value<std::string>(&geometry_name)->default_value("respeaker6"),
+                    "Array geometry: respeaker4, respeaker6, linear or circular.")
+            ("spacing, s", po::value<double>(&spacing)->default_value(0.05),
+                    "Distance between microphones of the linear array, or diameter of the circular one, in meters.")
+            ("duration, d", po::value<std::size_t>(&duration)->default_value(32),
+                    "Duration of every frame in milliseconds.")
+            ("chunk, c", po::value<std::size_t>(&chunk)->default_value(64), "Number of frames per task.")
+            ("threads, t", po::value<std::size_t>(&threads)->default_value(std::thread::hardware_concurrency()),
+                    "Number of threads.")
+            ("csv", po::bool_switch(&csv), "Writes the results as CSV instead of binary records.");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(ac, av, desc), vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << "\n";
+        std::cout << "Binary records, one per frame: time (float64), delay of every pair of microphones in seconds "
+                     "(float32), azimuth in degrees (float32) and confidence (float32)." << std::endl;
+        return 0;
+    }
+
+    po::notify(vm);
+
+    Decoder decoder(input);
+    if (!decoder.is_open()) {
+        std::cerr << "Error while opening " << input << std::endl;
+        return 1;
+    }
+
+    const auto sample_rate = static_cast<std::int32_t>(decoder.sampleRate());
+    const auto geometry = MakeGeometry(geometry_name, decoder.channels(), spacing);
+    if (geometry.size() != static_cast<std::size_t>(decoder.channels())) {
+        std::cerr << "The file has " << static_cast<int>(decoder.channels()) << " channels, the geometry "
+                  << geometry.size() << " microphones." << std::endl;
+        return 1;
+    }
+
+    BatchLocalizer batch(sample_rate, geometry, duration * static_cast<std::size_t>(sample_rate) / 1000);
+    batch.setChunkSize(chunk);
+    batch.setThreadPool(std::make_shared<ThreadPool>(std::max<std::size_t>(1, threads)));
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto& results = batch.process(decoder);
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::ofstream stream(output, csv ? std::ios::out : std::ios::out | std::ios::binary);
+    for (auto f = 0ul; f < results.frames(); ++f) {
+        const auto delays = results.delays.row(static_cast<Eigen::Index>(f));
+        if (csv) {
+            stream << results.time[f];
+            for (auto p = 0; p < delays.size(); ++p) {
+                stream << "," << delays[p];
+            }
+            stream << "," << results.azimuth[f] << "," << results.confidence[f] << "\n";
+        } else {
+            stream.write(reinterpret_cast<const char*>(&results.time[f]), sizeof(double));
+            stream.write(reinterpret_cast<const char*>(delays.data()), delays.size() * sizeof(float));
+            stream.write(reinterpret_cast<const char*>(&results.azimuth[f]), sizeof(float));
+            stream.write(reinterpret_cast<const char*>(&results.confidence[f]), sizeof(float));
+        }
+    }
+
+    std::cout << "Frames: " << results.frames() << " Pairs: " << results.delays.cols()
+              << " Elapsed: " << elapsed << " s Real-time factor: " << elapsed / decoder.duration() << std::endl;
+    return 0;
+}
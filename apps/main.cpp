@@ -31,11 +31,13 @@ int main() {
     auto downsampler = std::make_unique<ReSampler>(channels, 48000, sample_rate, ReSampler::Quality::HighQuality);
     auto gain = std::make_unique<Gain>(3);
 
-    auto e_original = std::make_unique<Encoder>("original.wav", sample_rate, channels);
-    auto e_clean_webrtc = std::make_unique<Encoder>("clean_webrtc.wav", sample_rate, channels);
-    auto e_upsampled = std::make_unique<Encoder>("upsampled_original.wav", 48000, channels);
-    auto e_downsampled = std::make_unique<Encoder>("downsampled_original.wav", sample_rate, channels);
-    auto e_clean_rnn = std::make_unique<Encoder>("clean_rnn.wav", 48000, channels);
+    auto e_original = std::make_unique<Encoder>("original.wav", sample_rate, channels, Encoder::Asynchronous);
+    auto e_clean_webrtc = std::make_unique<Encoder>("clean_webrtc.wav", sample_rate, channels,
+            Encoder::Asynchronous);
+    auto e_upsampled = std::make_unique<Encoder>("upsampled_original.wav", 48000, channels, Encoder::Asynchronous);
+    auto e_downsampled = std::make_unique<Encoder>("downsampled_original.wav", sample_rate, channels,
+            Encoder::Asynchronous);
+    auto e_clean_rnn = std::make_unique<Encoder>("clean_rnn.wav", 48000, channels, Encoder::Asynchronous);
 
     recorder->setOnRecordingStarted([](){
         std::cout << "Recording started" << std::endl;
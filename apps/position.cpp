@@ -4,6 +4,7 @@
 #include <encoder.hpp>
 #include <channel_remove.hpp>
 #include <pixel_ring.hpp>
+#include <pipeline.hpp>
 
 #include <iostream>
 #include <chrono>
@@ -20,6 +21,7 @@ int main(int ac, char* av[]) {
     std::int32_t channels;
     std::uint16_t vid, pid;
     std::size_t duration;
+    bool profile;
 
     po::options_description desc("Recording options");
     desc.add_options()
@@ -33,7 +35,8 @@ int main(int ac, char* av[]) {
             ("index, i", po::value<std::int32_t >(&device_index)->default_value(Recorder::DefaultInputDevice()),
                     "Device index. Default: default system input device.")
             ("vendor, v", po::value<std::uint16_t>(&vid)->default_value(0x2886), "Vendor ID")
-            ("product, p", po::value<std::uint16_t >(&pid)->default_value(0x0018), "Product ID");
+            ("product, p", po::value<std::uint16_t >(&pid)->default_value(0x0018), "Product ID")
+            ("profile", po::bool_switch(&profile), "Prints the timing statistics of every block as JSON.");
 
     po::variables_map vm;
     po::store(po::parse_command_line(ac, av, desc), vm);
@@ -63,34 +66,54 @@ int main(int ac, char* av[]) {
     //auto pixel = std::make_unique<PixelRing>(vid, pid);
     auto recorder = std::make_unique<Recorder>(sample_rate, channels, device_index, frames_per_buffer);
     auto gain = std::make_unique<Gain>(3);
-    auto encoder6 = std::make_unique<Encoder>("recorded_6ch.wav", sample_rate, channels);
-    auto encoder4 = std::make_unique<Encoder>("recorded_4ch.wav", sample_rate, remove->remaining());
+    auto encoder6 = std::make_unique<Encoder>("recorded_6ch.wav", sample_rate, channels, Encoder::Asynchronous);
+    auto encoder4 = std::make_unique<Encoder>("recorded_4ch.wav", sample_rate, remove->remaining(),
+            Encoder::Asynchronous);
 
     const std::vector<std::pair<std::size_t, std::size_t>> groups = {{0, 2}, {1, 3}};
-    auto doa = std::make_unique<DOA>(sample_rate, remove->remaining());
+    auto doa = std::make_unique<DOA>(sample_rate, ArrayGeometry::ReSpeaker4Mic());
     doa->setGroupMicrophones(groups);
 
     const auto total = static_cast<std::uint64_t >(duration) / 200;
     volatile auto iterations = total;
 
-    AudioBuffer data;
-    const auto processing = [&](AudioBuffer& recorded) {
-        encoder6->process(recorded);
-        remove->process(recorded, data);
-        gain->process(data, data);
-        encoder4->process(data);
+    float direction = 0;
+    Pipeline pipeline(sample_rate, static_cast<std::int8_t>(channels), static_cast<std::size_t>(frames_per_buffer));
+    pipeline.sinkBlock("encoder-6ch", *encoder6, Pipeline::Source);
+    pipeline.addBlock("remove", *remove, Pipeline::Source,
+            Pipeline::ChannelsFormat(static_cast<std::int8_t>(remove->remaining())));
+    const auto gained = pipeline.addBlock("gain", *gain, Pipeline::Previous, Pipeline::SameFormat(), true);
+    pipeline.sinkBlock("encoder-4ch", *encoder4, gained);
+    pipeline.sink("doa", [&](const AudioBufferView& input) {
+        direction = doa->process(input);
+    }, gained);
+    pipeline.build();
+
+    auto profiler = std::make_shared<Profiler>(profile);
+    const auto capture = profiler->registerBlock("recorder");
+    profiler->setClock([&recorder]() { return recorder->timestamp(); });
+    pipeline.setProfiler(profiler);
 
+    const auto processing = [&](AudioBuffer& recorded) {
+        pipeline.process(recorded);
         std::cout << "\r" << "Recording: " << 100 * static_cast<float>(total - --iterations) / total
-        << "% DOA: " << doa->process(data) << std::flush;
+        << "% DOA: " << direction << std::flush;
 
     };
 
     recorder->setOnRecordingStarted([](){ std::cout << "Recording started" << std::endl;  });
     recorder->setOnRecordingStopped([]() {  std::cout << std::endl << "Recording stopped" << std::endl;  });
     recorder->setOnProcessingBufferReady(processing);
+    // The pipeline runs in the processing thread, the frames it can not keep up with are counted as dropped.
+    recorder->setAsynchronous(true);
     recorder->record();
     while (iterations) {}
     recorder->stop();
 
+    if (profile) {
+        profiler->recordDropped(capture, recorder->queueStatistics().overflows);
+        std::cout << profiler->toJson() << std::endl;
+    }
+
     return 0;
 }
\ No newline at end of file
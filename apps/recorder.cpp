@@ -38,6 +38,7 @@ int main(int ac, char* av[]) {
 
     auto recorder = std::make_unique<Recorder>(sample_rate, channels, device_index, 0.01 * sample_rate);
     auto encoder = std::make_unique<Encoder>(filename, sample_rate, channels);
+    recorder->setAsynchronous(true);
     volatile auto iterations = static_cast<std::uint64_t >(duration) / 10;
     recorder->setOnRecordingStarted([](){ std::cout << "Recording started" << std::endl;  });
     recorder->setOnRecordingStopped([]() {  std::cout << "Recording stopped" << std::endl;  });
@@ -50,5 +51,10 @@ int main(int ac, char* av[]) {
     while (iterations) {
 
     }
+    recorder->stop();
+
+    const auto statistics = recorder->queueStatistics();
+    std::cout << "Overflows: " << statistics.overflows << " Underflows: " << statistics.underflows
+              << " Peak: " << statistics.peak << std::endl;
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef SMARTCORE_BENCHMARK_UTILS_HPP
+#define SMARTCORE_BENCHMARK_UTILS_HPP
+
+#include <audio_buffer.hpp>
+#include <benchmark/benchmark.h>
+
+#include <initializer_list>
+#include <random>
+
+namespace score {
+
+    /**
+     * @brief Creates a buffer filled with white noise in the FloatS16 range.
+     * @param sample_rate Sampling frequency in Hz.
+     * @param channels Number of channels.
+     * @param frames_per_channel Number of samples per channel.
+     * @return Buffer storing the noise.
+     */
+    inline AudioBuffer MakeNoise(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<float> distribution(-8000.f, 8000.f);
+        AudioBuffer buffer(sample_rate, channels, frames_per_channel);
+        for (auto i = 0ul; i < buffer.size(); ++i) {
+            buffer.data()[i] = distribution(generator);
+        }
+        return buffer;
+    }
+
+    /**
+     * @brief Reports the processed frames and the real-time factor (processing time / audio time).
+     * @param state State of the running benchmark.
+     * @param sample_rate Sampling frequency in Hz.
+     * @param frames_per_channel Number of samples per channel of each frame.
+     */
+    inline void ReportRealTime(benchmark::State& state, std::int32_t sample_rate, std::size_t frames_per_channel) {
+        const auto audio = static_cast<double>(state.iterations()) * frames_per_channel / sample_rate;
+        state.counters["frames/s"] = benchmark::Counter(static_cast<double>(state.iterations()),
+                benchmark::Counter::kIsRate);
+        state.counters["RTF"] = benchmark::Counter(audio, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    }
+
+    /**
+     * @brief Registers every combination of sample rate, channels and frame duration as {rate, channels, ms}.
+     */
+    inline void Sweep(benchmark::internal::Benchmark* benchmark, std::initializer_list<std::int64_t> rates,
+                      std::initializer_list<std::int64_t> channels, std::initializer_list<std::int64_t> durations) {
+        benchmark->ArgNames({"rate", "channels", "ms"});
+        for (const auto rate : rates) {
+            for (const auto channel : channels) {
+                for (const auto duration : durations) {
+                    benchmark->Args({rate, channel, duration});
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Extracts the {rate, channels, ms} arguments of a sweep.
+     */
+    struct SweepArguments {
+        explicit SweepArguments(const benchmark::State& state) :
+            sample_rate(static_cast<std::int32_t>(state.range(0))),
+            channels(static_cast<std::int8_t>(state.range(1))),
+            frames_per_channel(static_cast<std::size_t>(state.range(0) * state.range(2) / 1000)) {
+        }
+
+        std::int32_t sample_rate;
+        std::int8_t channels;
+        std::size_t frames_per_channel;
+    };
+}
+
+#endif //SMARTCORE_BENCHMARK_UTILS_HPP
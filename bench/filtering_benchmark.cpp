@@ -0,0 +1,103 @@
+#include "benchmark_utils.hpp"
+
+#include <filter.hpp>
+#include <fir.hpp>
+#include <gain.hpp>
+#include <low_cut_filter.hpp>
+#include <resample.hpp>
+#include <reverberation.hpp>
+
+using namespace score;
+
+static void BM_Gain(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    Gain gain(2.f);
+    for (auto _ : state) {
+        gain.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Gain)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 4, 8}, {10}); });
+
+static void BM_LowCutFilter(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    LowCutFilter filter(arguments.sample_rate, arguments.channels);
+    for (auto _ : state) {
+        filter.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_LowCutFilter)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {16000, 48000}, {1, 4, 8}, {10, 100});
+});
+
+static void BM_Filter(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    Filter filter(arguments.sample_rate, arguments.channels);
+    filter.setOrder(8);
+    filter.setCutOff(1000);
+    for (auto _ : state) {
+        filter.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Filter)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 4, 8}, {10}); });
+
+static void BM_FIR(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const std::vector<float> coefficients(64, 1.f / 64);
+    AudioBuffer output;
+    FIR fir(arguments.channels, coefficients.data(), coefficients.size());
+    for (auto _ : state) {
+        fir.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_FIR)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 4, 8}, {10}); });
+
+static void BM_ReSampler(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto quality = static_cast<ReSampler::Quality>(state.range(3));
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    ReSampler resampler(arguments.channels, arguments.sample_rate, 48000, quality);
+    for (auto _ : state) {
+        resampler.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_ReSampler)->ArgNames({"rate", "channels", "ms", "quality"})
+        ->Args({16000, 1, 10, static_cast<std::int64_t>(ReSampler::Quality::HighQuality)})
+        ->Args({16000, 1, 10, static_cast<std::int64_t>(ReSampler::Quality::LowQuality)})
+        ->Args({16000, 4, 10, static_cast<std::int64_t>(ReSampler::Quality::HighQuality)})
+        ->Args({16000, 4, 10, static_cast<std::int64_t>(ReSampler::Quality::LowQuality)});
+
+static void BM_Reverberation(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    Reverberation reverberation(arguments.sample_rate, static_cast<std::uint8_t>(arguments.channels),
+            arguments.frames_per_channel);
+    reverberation.setRoomDimension(5, 4, 3);
+    reverberation.setSource({2, 3.5, 2});
+    reverberation.setReverberationTime(0.4f);
+    reverberation.setReceivers(Vector<Point<float>>(static_cast<std::size_t>(arguments.channels), {2, 1.5, 2}));
+    for (auto _ : state) {
+        reverberation.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Reverberation)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000}, {1, 2}, {10}); });
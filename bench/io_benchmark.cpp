@@ -0,0 +1,54 @@
+#include "benchmark_utils.hpp"
+
+#include <decoder.hpp>
+#include <encoder.hpp>
+
+#include <cstdio>
+
+using namespace score;
+
+static void BM_Encoder(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto mode = static_cast<Encoder::Mode>(state.range(3));
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const std::string file = "smartcore_bench_encoder.wav";
+    {
+        Encoder encoder(file, arguments.sample_rate, arguments.channels, mode);
+        for (auto _ : state) {
+            encoder.process(input);
+        }
+    }
+    std::remove(file.c_str());
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Encoder)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rate", "channels", "ms", "mode"});
+    for (const auto mode : {Encoder::Synchronous, Encoder::Asynchronous}) {
+        for (const auto channels : {1, 8}) {
+            b->Args({48000, channels, 10, mode});
+        }
+    }
+});
+
+static void BM_Decoder(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const std::string file = "smartcore_bench_decoder.wav";
+    {
+        const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.sample_rate);
+        Encoder encoder(file, arguments.sample_rate, arguments.channels);
+        encoder.process(input);
+    }
+
+    AudioBuffer output;
+    Decoder decoder(file);
+    for (auto _ : state) {
+        if (decoder.current() + arguments.frames_per_channel > decoder.framesPerChannel()) {
+            decoder.seek(0);
+        }
+        decoder.process(output, arguments.frames_per_channel);
+        benchmark::DoNotOptimize(output.data());
+    }
+    std::remove(file.c_str());
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Decoder)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 8}, {10}); });
@@ -0,0 +1,139 @@
+#include "benchmark_utils.hpp"
+
+#include <batch_localizer.hpp>
+#include <beamformer.hpp>
+#include <doa.hpp>
+#include <music.hpp>
+#include <srp_phat.hpp>
+#include <tdoa.hpp>
+
+#include <cmath>
+
+using namespace score;
+
+static void BM_TDOA(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    TDOA tdoa(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tdoa.process(input));
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_TDOA)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {2, 4, 8}, {16, 64}); });
+
+static void BM_DOA(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    DOA doa(arguments.sample_rate, static_cast<std::uint8_t>(arguments.channels));
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    for (auto i = 0ul; i < static_cast<std::size_t>(arguments.channels) / 2; ++i) {
+        groups.emplace_back(i, i + arguments.channels / 2);
+    }
+    doa.setGroupMicrophones(groups);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(doa.process(input));
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_DOA)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {4, 6, 8}, {16, 64}); });
+
+static void BM_BatchLocalizer(benchmark::State& state) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t FramesPerChannel = 512;
+    constexpr std::size_t Frames = 1024;
+    const auto threads = static_cast<std::size_t>(state.range(0));
+    const auto geometry = ArrayGeometry::ReSpeaker6Mic();
+    const auto recording = MakeNoise(SampleRate, static_cast<std::int8_t>(geometry.size()), Frames * FramesPerChannel);
+    BatchLocalizer batch(SampleRate, geometry, FramesPerChannel);
+    batch.setThreadPool(std::make_shared<ThreadPool>(threads));
+    for (auto _ : state) {
+        batch.reset();
+        benchmark::DoNotOptimize(batch.process(recording).azimuth.data());
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * Frames));
+}
+BENCHMARK(BM_BatchLocalizer)->ArgName("threads")->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+static void BM_SrpPhat(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    std::vector<Point<float>> microphones;
+    for (auto i = 0; i < arguments.channels; ++i) {
+        const auto angle = 2 * M_PI * i / arguments.channels;
+        microphones.push_back({0.0463 * std::cos(angle), 0.0463 * std::sin(angle), 0});
+    }
+    SrpPhat srp(arguments.sample_rate, arguments.frames_per_channel, microphones);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(srp.process(input));
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_SrpPhat)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {4, 6, 8}, {10, 32}); });
+
+static void BM_Music(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    std::vector<Point<float>> microphones;
+    for (auto i = 0; i < arguments.channels; ++i) {
+        const auto angle = 2 * M_PI * i / arguments.channels;
+        microphones.push_back({0.0463 * std::cos(angle), 0.0463 * std::sin(angle), 0});
+    }
+    Music music(arguments.sample_rate, arguments.frames_per_channel, microphones);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(music.process(input));
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Music)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000}, {4, 6, 8}, {32}); });
+
+static void BM_Beamformer(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto method = static_cast<Beamformer::Method>(state.range(3));
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    Beamformer beamformer(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    beamformer.setMethod(method);
+    for (auto _ : state) {
+        beamformer.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_Beamformer)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rate", "channels", "ms", "method"});
+    for (const auto method : {Beamformer::DelayAndSum, Beamformer::FractionalDelayAndSum, Beamformer::MVDR,
+                              Beamformer::GSC}) {
+        for (const auto channels : {4, 8}) {
+            b->Args({16000, channels, 32, method});
+        }
+    }
+});
+
+static void BM_BeamBank(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto beams = static_cast<std::size_t>(state.range(3));
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    Beamformer beamformer(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    beamformer.setMethod(Beamformer::BeamBank);
+    beamformer.setGeometry(ArrayGeometry::Circular(static_cast<std::size_t>(arguments.channels), 0.05));
+    std::vector<float> azimuths(beams);
+    for (auto i = 0ul; i < beams; ++i) {
+        azimuths[i] = 360.0f * static_cast<float>(i) / static_cast<float>(beams);
+    }
+    beamformer.setBeams(azimuths);
+    for (auto _ : state) {
+        beamformer.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_BeamBank)->Apply([](benchmark::internal::Benchmark* b) {
+    b->ArgNames({"rate", "channels", "ms", "beams"});
+    for (const auto beams : {1, 6, 12}) {
+        for (const auto channels : {4, 8}) {
+            b->Args({16000, channels, 32, beams});
+        }
+    }
+});
@@ -0,0 +1,161 @@
+#include "benchmark_utils.hpp"
+
+#include <acoustic_echo_canceller.hpp>
+#include <automatic_gain_control.hpp>
+#include <delay_aligner.hpp>
+#include <dereverberation.hpp>
+#include <noise_suppression.hpp>
+#include <rnn_vad.hpp>
+#include <speex_preprocessor.hpp>
+#include <vad.hpp>
+
+using namespace score;
+
+static void BM_AEC(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto recorded = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto played = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto filter_length = static_cast<std::size_t>(0.2 * arguments.sample_rate);
+    AudioBuffer output;
+    AEC aec(arguments.sample_rate, arguments.channels, arguments.frames_per_channel, filter_length);
+    for (auto _ : state) {
+        aec.process(recorded, played, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_AEC)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 4, 8}, {10, 20}); });
+
+static void BM_AEC3(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto recorded = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto played = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto filter_length = static_cast<std::size_t>(0.2 * arguments.sample_rate);
+    AudioBuffer output;
+    AEC aec(arguments.sample_rate, arguments.channels, arguments.frames_per_channel, filter_length,
+            AEC::WebRTCAEC3);
+    for (auto _ : state) {
+        aec.process(recorded, played, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_AEC3)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {16000, 48000}, {1, 4, 8}, {10, 20}); });
+
+static void BM_AECSharedReference(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto recorded = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto played = MakeNoise(arguments.sample_rate, 2, arguments.frames_per_channel);
+    const auto filter_length = static_cast<std::size_t>(0.2 * arguments.sample_rate);
+    AudioBuffer output;
+    auto aec = AEC::MultiReference(arguments.sample_rate, arguments.channels, 2, arguments.frames_per_channel,
+                                    filter_length);
+    for (auto _ : state) {
+        aec.process(recorded, played, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_AECSharedReference)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {16000, 48000}, {2, 4, 8}, {10, 20});
+});
+
+static void BM_DelayAligner(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto recorded = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    const auto played = MakeNoise(arguments.sample_rate, 2, arguments.frames_per_channel);
+    AudioBuffer aligned;
+    DelayAligner aligner(arguments.sample_rate, 2, arguments.frames_per_channel,
+                         static_cast<std::size_t>(0.3 * arguments.sample_rate));
+    for (auto _ : state) {
+        aligner.process(recorded, played, aligned);
+        benchmark::DoNotOptimize(aligned.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_DelayAligner)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {16000, 48000}, {2, 4, 8}, {10, 20});
+});
+
+static void BM_NoiseSuppression(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    NoiseSuppression suppressor(arguments.sample_rate, arguments.channels, NoiseSuppression::Aggressive);
+    for (auto _ : state) {
+        suppressor.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_NoiseSuppression)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {8000, 16000}, {1, 4, 8}, {10});
+});
+
+static void BM_AGC(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    AGC agc(arguments.sample_rate, arguments.channels, AGC::AdaptiveDigital);
+    for (auto _ : state) {
+        agc.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_AGC)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {8000, 16000}, {1, 2}, {10}); });
+
+static void BM_DeReverberation(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    DeReverberation dereverberation(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    for (auto _ : state) {
+        dereverberation.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_DeReverberation)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {16000, 48000}, {1, 4, 8}, {10});
+});
+
+static void BM_SpeexPreprocessor(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    AudioBuffer output;
+    SpeexPreprocessor preprocessor(arguments.sample_rate, arguments.channels, arguments.frames_per_channel,
+                                   SpeexPreprocessor::Denoise | SpeexPreprocessor::DeReverb
+                                   | SpeexPreprocessor::VoiceDetection);
+    for (auto _ : state) {
+        preprocessor.process(input, output);
+        benchmark::DoNotOptimize(output.data());
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_SpeexPreprocessor)->Apply([](benchmark::internal::Benchmark* b) {
+    Sweep(b, {16000, 48000}, {1, 4, 8}, {10});
+});
+
+static void BM_VAD(benchmark::State& state) {
+    const SweepArguments arguments(state);
+    const auto input = MakeNoise(arguments.sample_rate, arguments.channels, arguments.frames_per_channel);
+    VAD vad(arguments.sample_rate, VAD::Aggressive);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vad.process(input));
+    }
+    ReportRealTime(state, arguments.sample_rate, arguments.frames_per_channel);
+}
+BENCHMARK(BM_VAD)->Apply([](benchmark::internal::Benchmark* b) { Sweep(b, {8000, 16000, 48000}, {1}, {10, 30}); });
+
+static void BM_DeepVAD(benchmark::State& state) {
+    constexpr auto SampleRate = 24000;
+    constexpr auto FramesPerChannel = 240ul;
+    const auto input = MakeNoise(SampleRate, 1, FramesPerChannel);
+    DeepVAD vad;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(vad.process(input));
+    }
+    ReportRealTime(state, SampleRate, FramesPerChannel);
+}
+BENCHMARK(BM_DeepVAD);
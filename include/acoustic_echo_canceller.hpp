@@ -2,24 +2,69 @@
 #define SMARTCORE_ECHO_CANCELLER_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
 
     class AEC {
     public:
+
+        /**
+         * @brief The Backend enum defines the implementation used to cancel the echo of every channel.
+         */
+        enum Backend {
+            SpeexMDF = 0,   /*!< Multidelay block frequency-domain filter of Speex, working with 16-bit samples */
+            WebRTCAEC3      /*!< Echo Canceller 3 of WebRTC, working with floats in split bands of 10 ms frames */
+        };
+
         /**
          * @brief Creates a new multi-channel echo canceller
          * @param sample_rate Sampling rate in Hz
          * @param frame_size Number of samples to process at one time (should correspond to 10-20 ms)
          * @param filter_length Number of samples of echo to cancel (should generally correspond to 100-500 ms)
          * @param channels Number of channels
+         * @param backend Implementation of the canceller. WebRTCAEC3 requires a sampling rate of 8, 16, 32 or 48 kHz
+         * and frames of a multiple of 10 ms.
+         * @throws std::invalid_argument if the configuration is not supported by the backend.
          *
          * @note The filter length is also known as tail length. The recommended tail length is approximately
          * the third of the room reverberation time. When it comes to echo tail length (filter length), longer is *not*
          * better. Actually, the longer the tail length, the longer it takes for the filter to adapt.
          */
-        AEC(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t filter_length);
+        AEC(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t filter_length,
+            Backend backend = SpeexMDF);
+
+        /**
+         * @brief Creates an echo canceller for an array of microphones sharing the same loudspeakers
+         *
+         * Every microphone cancels the echo of the reference channels. With SpeexMDF, a single multi-channel state
+         * transforms the references once per frame and shares them with all the microphones. With WebRTCAEC3, only
+         * the band split of the reference is shared: every microphone still runs its own canceller, which analyses
+         * the reference again (render FFT, history and delay estimation), so the cost grows with the microphones.
+         *
+         * @param sample_rate Sampling rate in Hz
+         * @param channels Number of microphone channels
+         * @param references Number of reference channels, those sent to the loudspeakers
+         * @param frame_size Number of samples to process at one time (should correspond to 10-20 ms)
+         * @param filter_length Number of samples of echo to cancel (should generally correspond to 100-500 ms)
+         * @param backend Implementation of the canceller.
+         * @throws std::invalid_argument if the configuration is not supported by the backend, in particular if
+         * WebRTCAEC3 is used with more than one reference channel.
+         * @return Echo canceller.
+         */
+        static AEC MultiReference(std::int32_t sample_rate, std::int8_t channels, std::int8_t references,
+                                  std::size_t frame_size, std::size_t filter_length, Backend backend = SpeexMDF);
+
+        /**
+         * @brief Move constructor
+         */
+        AEC(AEC&& other) noexcept;
+
+        /**
+         * @brief Move assignment
+         */
+        AEC& operator=(AEC&& other) noexcept;
 
         /**
          * @brief Default destructor
@@ -31,7 +76,7 @@ namespace score {
          * to playback in this form)
          *
          * @param recorded Signal from the microphone (near end + far end echo)
-         * @param played Signal played to the speaker (received from far end)
+         * @param played Signal played to the speaker (received from far end), one channel per reference
          * @param output Returns near-end signal with echo removed
          *
          * @note The input signal and the echo signal must be small enough because otherwise part of the
@@ -41,11 +86,50 @@ namespace score {
          * @note Using a different sound card to do the capture and playback will *not* work. The sources may be generated
          * from the same sound card.
          */
-        void process(const AudioBuffer& recorded, const AudioBuffer& played, AudioBuffer& output);
+        void process(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Each channel runs its own echo canceller, so the output does not depend on the pool. The Speex
+         * backend with shared references cancels all the channels in a single state and does not use the pool.
+         * @note Short frames are processed serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
+
+        /**
+         * @brief Returns the implementation used to cancel the echo.
+         * @return Backend of the canceller.
+         */
+        Backend backend() const;
+
+        /**
+         * @brief Returns the number of reference channels expected by process().
+         * @return Number of reference channels.
+         */
+        std::int8_t references() const;
+
+        /**
+         * @brief Returns the delay between the played and the recorded signals estimated by the canceller.
+         * @param channel Index of the channel.
+         * @return Delay in milliseconds.
+         * @throws std::runtime_error if the backend does not estimate it (SpeexMDF).
+         */
+        std::int32_t delay(std::size_t channel = 0) const;
 
+        /**
+         * @brief Returns the Echo Return Loss Enhancement, the attenuation of the echo achieved by the canceller.
+         * @param channel Index of the channel.
+         * @return ERLE in dB.
+         * @throws std::runtime_error if the backend does not estimate it (SpeexMDF).
+         */
+        float erle(std::size_t channel = 0) const;
 
     private:
+        friend struct AECInternals;
+
         struct Pimpl;
+        explicit AEC(std::unique_ptr<Pimpl> pimpl);
         std::unique_ptr<Pimpl> pimpl_;
     };
 }
@@ -0,0 +1,121 @@
+#ifndef SMARTCORE_ARRAY_GEOMETRY_HPP
+#define SMARTCORE_ARRAY_GEOMETRY_HPP
+
+#include <types.hpp>
+
+namespace score {
+
+    /**
+     * @brief Positions of the microphones of an array, in meters.
+     *
+     * The axes follow the usual convention of the localization blocks: the azimuth is measured in the XY plane from
+     * the X axis, counterclockwise, and the elevation is measured from the XY plane towards the Z axis.
+     */
+    class ArrayGeometry {
+    public:
+
+        /**
+         * @brief Creates an array from the position of its microphones.
+         * @param microphones Position of every microphone in meters, in the same order as the channels.
+         */
+        ArrayGeometry(const std::vector<Point<float>>& microphones);
+
+        /**
+         * @brief Creates a uniform linear array along the X axis, centered in the origin.
+         * @param microphones Number of microphones.
+         * @param spacing Distance between two consecutive microphones in meters.
+         * @return Geometry of the array.
+         */
+        static ArrayGeometry Linear(std::size_t microphones, double spacing);
+
+        /**
+         * @brief Creates a uniform circular array in the XY plane, centered in the origin.
+         * @param microphones Number of microphones.
+         * @param radius Radius of the circle in meters.
+         * @param offset Azimuth of the first microphone in degrees.
+         * @return Geometry of the array.
+         */
+        static ArrayGeometry Circular(std::size_t microphones, double radius, double offset = 0);
+
+        /**
+         * @brief Creates the geometry of the ReSpeaker 4-Mic array, a square with a diagonal of 81.27 mm.
+         * @return Geometry of the array.
+         */
+        static ArrayGeometry ReSpeaker4Mic();
+
+        /**
+         * @brief Creates the geometry of the ReSpeaker 6-Mic circular array, a hexagon with a diagonal of 92.18 mm.
+         * @return Geometry of the array.
+         */
+        static ArrayGeometry ReSpeaker6Mic();
+
+        /**
+         * @brief Returns the number of microphones.
+         * @return Number of microphones.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the position of the microphones.
+         * @return Position of every microphone in meters.
+         */
+        const std::vector<Point<float>>& microphones() const;
+
+        /**
+         * @brief Returns the position of a microphone.
+         * @param index Index of the microphone.
+         * @return Position in meters.
+         */
+        const Point<float>& operator[](std::size_t index) const;
+
+        /**
+         * @brief Returns the distance between two microphones.
+         * @param first Index of the first microphone.
+         * @param second Index of the second microphone.
+         * @return Distance in meters.
+         */
+        double distance(std::size_t first, std::size_t second) const;
+
+        /**
+         * @brief Returns the maximum distance between two microphones of the array.
+         * @return Aperture in meters.
+         */
+        double aperture() const;
+
+        /**
+         * @brief Returns the maximum delay, in samples, that a far-field source can induce between two microphones.
+         * @param first Index of the first microphone.
+         * @param second Index of the second microphone.
+         * @param sample_rate Sampling rate in Hz.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @return Maximum delay in samples, rounded up.
+         */
+        std::int32_t maximumDelay(std::size_t first, std::size_t second, std::int32_t sample_rate,
+                                  float sound_speed) const;
+
+        /**
+         * @brief Computes the time of arrival of a far-field source at every microphone, for a grid of directions.
+         * The delays are relative to the arrival at the origin of the coordinates: negative values arrive earlier.
+         * @param azimuths Azimuths of the grid in degrees.
+         * @param elevations Elevations of the grid in degrees.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @return Matrix of (elevations x azimuths) rows, sorted by elevation and then by azimuth, and one column
+         * per microphone holding the delay in seconds.
+         */
+        Matrix<float> arrivalDelays(const std::vector<float>& azimuths, const std::vector<float>& elevations,
+                                    float sound_speed) const;
+
+        /**
+         * @brief Returns the azimuths of a uniform grid covering the whole circle.
+         * @param step Step of the grid in degrees.
+         * @return Azimuths in degrees: 0, step, 2 * step...
+         */
+        static std::vector<float> AzimuthGrid(float step);
+
+    private:
+        std::vector<Point<float>> microphones_;
+    };
+
+}
+
+#endif //SMARTCORE_ARRAY_GEOMETRY_HPP
@@ -2,6 +2,7 @@
 #define SMARTCORE_AUDIO_BUFFER_HPP
 
 #include <types.hpp>
+#include <audio_buffer_view.hpp>
 
 namespace score {
 
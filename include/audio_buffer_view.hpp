@@ -0,0 +1,217 @@
+#ifndef SMARTCORE_AUDIO_BUFFER_VIEW_HPP
+#define SMARTCORE_AUDIO_BUFFER_VIEW_HPP
+
+#include <types.hpp>
+
+namespace score {
+
+    class AudioBuffer;
+
+    /**
+     * @brief Non-owning view over the samples of a multi-channel audio frame.
+     *
+     * A view stores one pointer per channel and the distance (stride) between two consecutive samples of the
+     * same channel. Deinterleaved memory, such as an AudioBuffer, has a stride of 1, while interleaved memory,
+     * such as the buffers delivered by the sound card drivers, has a stride equal to the number of channels.
+     *
+     * @note The view does not extend the lifetime of the underlying memory.
+     */
+    class AudioBufferView {
+    public:
+
+        /**
+         * @brief Maximum number of channels that a view can reference.
+         */
+        static constexpr std::size_t MaximumChannels = 16;
+
+        /**
+         * @brief Creates an empty view.
+         */
+        AudioBufferView();
+
+        /**
+         * @brief Creates a view over the given channels.
+         * @param sample_rate Sample rate in Hz.
+         * @param channels Number of channels.
+         * @param frames_per_channel Number of samples per channel.
+         * @param data Array of pointers to the first sample of each channel.
+         * @param stride Distance between two consecutive samples of the same channel.
+         * @throws std::invalid_argument if the number of channels exceeds MaximumChannels.
+         */
+        AudioBufferView(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+                float* const* data, std::size_t stride = 1);
+
+        /**
+         * @brief Creates a view over the samples of an AudioBuffer.
+         * @param buffer Buffer holding the samples.
+         */
+        AudioBufferView(AudioBuffer& buffer);
+
+        /**
+         * @brief Creates a read-only view over the samples of an AudioBuffer.
+         * @note The samples must not be modified through the view.
+         * @param buffer Buffer holding the samples.
+         */
+        AudioBufferView(const AudioBuffer& buffer);
+
+        /**
+         * @brief Creates a view over a buffer of interleaved samples.
+         * @param sample_rate Sample rate in Hz.
+         * @param channels Number of channels.
+         * @param frames_per_channel Number of samples per channel.
+         * @param raw Array of raw data holding the interleaved samples.
+         * @return View over the interleaved samples.
+         */
+        static AudioBufferView FromInterleave(std::int32_t sample_rate, std::int8_t channels,
+                std::size_t frames_per_channel, float* raw);
+
+        /**
+         * @brief Returns the sampling rate.
+         * @return Sample rate in Hz.
+         */
+        std::int32_t sampleRate() const;
+
+        /**
+         * @brief Returns the number of channels in the view.
+         * @return Number of channels.
+         */
+        std::int8_t channels() const;
+
+        /**
+         * @brief Returns the number of samples per channel.
+         * @return Number of samples per channel.
+         */
+        std::size_t framesPerChannel() const;
+
+        /**
+         * @brief Returns the distance between two consecutive samples of the same channel.
+         * @return Stride in samples.
+         */
+        std::size_t stride() const;
+
+        /**
+         * @brief Checks if the samples of every channel are stored contiguously (stride of 1).
+         * @return True if the channels are contiguous, false otherwise.
+         */
+        bool isContiguous() const;
+
+        /**
+         * @brief Checks if the view references a single block of interleaved samples.
+         * @return True if the samples are interleaved, false otherwise.
+         */
+        bool isInterleaved() const;
+
+        /**
+         * @brief Returns the number of samples referenced by the view.
+         * @return Number of channels times the number of samples per channel.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the duration of the frame
+         * @return Duration of the frame in msecs.
+         */
+        std::size_t duration() const;
+
+        /**
+         * @brief Returns the time when the first sample of the frame was processed by the sound card.
+         * @return Timestamp in seconds
+         */
+        double timestamp() const;
+
+        /**
+         * @brief Sets the time when the first sample of the frame was processed by the sound card.
+         * @param timestamp Timestamp in seconds
+         */
+        void setTimestamp(double timestamp);
+
+        /**
+         * @brief Returns the type of the frame
+         * @see FrameType
+         * @return Type of the frame
+         */
+        FrameType type() const;
+
+        /**
+         * @brief Set the type of the frame
+         * @param type Type of frame
+         */
+        void setType(FrameType type);
+
+        /**
+         * @brief Returns a pointer to the first sample of the given channel.
+         * @param channel Desired channel.
+         * @return Pointer to the channel's samples.
+         */
+        float* channel(std::size_t channel);
+
+        /**
+         * @brief Returns a pointer to the first sample of the given channel.
+         * @param channel Desired channel.
+         * @return Pointer to the channel's samples.
+         */
+        const float* channel(std::size_t channel) const;
+
+        /**
+         * @brief Returns a pointer to the first sample of the given channel.
+         * @param channel Desired channel.
+         * @return Pointer to the channel's samples.
+         */
+        float* operator[](std::size_t channel);
+
+        /**
+         * @brief Returns a pointer to the first sample of the given channel.
+         * @param channel Desired channel.
+         * @return Pointer to the channel's samples.
+         */
+        const float* operator[](std::size_t channel) const;
+
+        /**
+         * @brief Returns a sample of the given channel, taking into account the stride.
+         * @param channel Desired channel.
+         * @param index Index of the sample in the channel.
+         * @return Reference to the sample.
+         */
+        float& operator()(std::size_t channel, std::size_t index);
+
+        /**
+         * @brief Returns a sample of the given channel, taking into account the stride.
+         * @param channel Desired channel.
+         * @param index Index of the sample in the channel.
+         * @return The sample.
+         */
+        float operator()(std::size_t channel, std::size_t index) const;
+
+        /**
+         * @brief Returns a view referencing a subset of the channels, without copying any sample.
+         * @param indexes Indexes of the selected channels.
+         * @return View over the selected channels.
+         */
+        AudioBufferView select(const std::vector<std::size_t>& indexes) const;
+
+        /**
+         * @brief Copies the samples of the view in to a buffer.
+         * @param buffer Buffer where the samples are copied.
+         */
+        void copyTo(AudioBuffer& buffer) const;
+
+        /**
+         * @brief Writes the samples of the view as interleaved raw data.
+         * The length of the array is equal to channels * framesPerChannel
+         * @param data Array of data where to store the interleaved data.
+         */
+        void toInterleave(float* data) const;
+
+    private:
+        FrameType type_{FrameType::Unknown};
+        double timestamp_{};
+        std::int32_t sample_rate_{};
+        std::int8_t channels_{};
+        std::size_t frames_per_channel_{};
+        std::size_t stride_{1};
+        Array<float*, MaximumChannels> data_{};
+    };
+
+}
+
+#endif //SMARTCORE_AUDIO_BUFFER_VIEW_HPP
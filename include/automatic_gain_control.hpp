@@ -147,7 +147,7 @@ namespace score {
          * @param input Vector storing the input audio samples.
          * @param output Vector storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
 
     private:
         struct Pimpl;
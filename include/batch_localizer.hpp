@@ -0,0 +1,110 @@
+#ifndef SMARTCORE_BATCH_LOCALIZER_HPP
+#define SMARTCORE_BATCH_LOCALIZER_HPP
+
+#include <array_geometry.hpp>
+#include <audio_buffer_view.hpp>
+#include <thread_pool.hpp>
+#include <memory>
+
+namespace score {
+
+    class Decoder;
+
+    /**
+     * @brief Offline direction of arrival of whole recordings.
+     *
+     * The frames of GCC-PHAT are independent, so the recording is split in chunks of consecutive frames that are
+     * localized in parallel, every thread with its own DOA block. Files are streamed in blocks that keep every
+     * thread of the pool busy, so the audio held in memory does not depend on the length of the recording. The
+     * results hold one row per frame, reserved upfront for files and grown geometrically for recordings in memory.
+     */
+    class BatchLocalizer {
+    public:
+
+        /**
+         * @brief Per-frame results, stored as one array per field.
+         */
+        struct Results {
+            Vector<double> time{};          /*!< Time of the first sample of every frame, in seconds */
+            Matrix<float> delays{};         /*!< Delay of every group of microphones in every frame, in seconds */
+            Vector<float> azimuth{};        /*!< Direction of arrival of every frame, in degrees */
+            Vector<float> confidence{};     /*!< Confidence of every frame, see DOA::confidence */
+
+            /**
+             * @brief Returns the number of frames.
+             * @return Number of frames.
+             */
+            std::size_t frames() const {
+                return time.size();
+            }
+        };
+
+        /**
+         * @brief Creates a localizer for the given array of microphones.
+         * @param sample_rate Sampling rate in Hz.
+         * @param geometry Geometry of the array, with the microphones in the same order as the channels.
+         * @param frames_per_channel Number of samples per channel of every analysed frame.
+         * @param sound_speed Speed of the sound in m/sec.
+         */
+        BatchLocalizer(std::int32_t sample_rate, const ArrayGeometry& geometry, std::size_t frames_per_channel,
+                float sound_speed = 343.2f);
+
+        /**
+         * @brief Default destructor
+         */
+        ~BatchLocalizer();
+
+        /**
+         * @brief Sets the group of microphones, given by pair of indexes. By default, every pair is used.
+         * @param microphone_groups Group of microphones
+         * @see DOA::setGroupMicrophones
+         */
+        void setGroupMicrophones(const std::vector<std::pair<std::size_t, std::size_t>>& microphone_groups);
+
+        /**
+         * @brief Sets the number of consecutive frames processed by a task.
+         * @param frames Number of frames, 64 by default.
+         */
+        void setChunkSize(std::size_t frames);
+
+        /**
+         * @brief Sets the pool used to process the chunks in parallel.
+         * @param pool Pool of threads, or nullptr to process the chunks serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
+
+        /**
+         * @brief Localizes every complete frame of a recording held in memory and appends the results.
+         * @param recording View over the whole recording. Its timestamp is the time of the first frame.
+         * @return Results of every frame processed so far.
+         * @throws std::invalid_argument if the recording does not match the configured format.
+         */
+        const Results& process(const AudioBufferView& recording);
+
+        /**
+         * @brief Streams an audio file from its current position to its end, localizing every complete frame.
+         * @param decoder Opened audio file.
+         * @return Results of every frame processed so far.
+         * @throws std::invalid_argument if the file does not match the configured format.
+         */
+        const Results& process(Decoder& decoder);
+
+        /**
+         * @brief Returns the results of every frame processed so far.
+         * @return Per-frame results.
+         */
+        const Results& results() const;
+
+        /**
+         * @brief Re-initializes the block, clearing the results.
+         */
+        void reset();
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_BATCH_LOCALIZER_HPP
@@ -1,6 +1,7 @@
 #ifndef SMARTCORE_BEAMFORMER_HPP
 #define SMARTCORE_BEAMFORMER_HPP
 
+#include <array_geometry.hpp>
 #include <audio_buffer.hpp>
 #include <memory>
 
@@ -10,9 +11,16 @@ namespace score {
     public:
 
         enum Method {
-            DelayAndSum,
+            DelayAndSum,            /*!< Delays rounded to whole samples, without latency */
             MVDR,
-            GSC
+            GSC,
+            FractionalDelayAndSum,  /*!< Fractional delays applied in the frequency domain, with one frame of latency */
+            BeamBank                /*!< Fractional delay-and-sum towards several fixed directions, see setBeams */
+        };
+
+        enum BeamSelection {
+            AllBeams,               /*!< One output channel per beam */
+            LoudestBeam             /*!< A single output channel with the beam of highest energy */
         };
 
         /**
@@ -20,7 +28,8 @@ namespace score {
          * @param sample_rate Sampling rate in Hz.
          * @param channels Number of channels
          * @param frames_per_channel Number of frames per channel
-         * @param learning_rate Learning rate of the GSC algorithm
+         * @param learning_rate Normalized step size of the interference canceller of GSC, which is adapted per
+         * frequency bin in frames that are not of type FrameType::Voice.
          * @param reference Reference microphone for the TDOA estimation.
          */
         Beamformer(std::int32_t sample_rate,
@@ -41,6 +50,65 @@ namespace score {
         void setMargin(std::int32_t margin);
 
 
+        /**
+         * @brief Sets the geometry of the array, used to compute the delays of every channel, with respect to the
+         * reference one, when the beam is steered.
+         * @param geometry Geometry of the array, with the microphones in the same order as the channels.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @throws std::invalid_argument if the number of microphones does not match the number of channels.
+         */
+        void setGeometry(const ArrayGeometry& geometry, float sound_speed = 343.2f);
+
+        /**
+         * @brief Steers the beam towards a fixed direction, computing the exact delays from the geometry of the array
+         * instead of estimating them in every frame. DelayAndSum rounds them to whole samples, the other methods
+         * apply them as fractional delays. Calling ignoreTimeDelays releases the beam.
+         * @param azimuth Azimuth in degrees, measured from the X axis.
+         * @param elevation Elevation in degrees, measured from the XY plane.
+         * @throws std::runtime_error if the geometry of the array is not configured.
+         */
+        void steer(float azimuth, float elevation = 0.0f);
+
+        /**
+         * @brief Sets the look directions of the BeamBank method. The input channels are transformed once per frame
+         * and every beam is a product of precomputed weights with the spectra, so every extra beam is cheap.
+         * @param azimuths Azimuth of every beam in degrees, measured from the X axis.
+         * @param elevation Elevation of all the beams in degrees, measured from the XY plane.
+         * @throws std::runtime_error if the geometry of the array is not configured.
+         * @throws std::invalid_argument if the number of beams is not in the range [1, 127].
+         */
+        void setBeams(const std::vector<float>& azimuths, float elevation = 0.0f);
+
+        /**
+         * @brief Returns the number of beams of the BeamBank method.
+         * @return Number of beams, zero if they are not configured.
+         */
+        std::size_t beams() const;
+
+        /**
+         * @brief Sets the output of the BeamBank method, LoudestBeam by default.
+         * @param selection All the beams, or the one of highest energy.
+         */
+        void setBeamSelection(BeamSelection selection);
+
+        /**
+         * @brief Returns the output of the BeamBank method.
+         * @return All the beams, or the one of highest energy.
+         */
+        BeamSelection beamSelection() const;
+
+        /**
+         * @brief Returns the beam of highest energy in the last frame that was not of type FrameType::Noise.
+         * @return Index of the beam in the list given to setBeams.
+         */
+        std::size_t selectedBeam() const;
+
+        /**
+         * @brief Checks if the beam is steered towards a fixed azimuth.
+         * @return True if the delays come from the geometry of the array, false if they are estimated.
+         */
+        bool isSteered() const;
+
         /**
          * @brief Returns the current operation mode (technique)
          * @return Method used to perform the beam-forming.
@@ -55,10 +123,27 @@ namespace score {
 
         /**
          * @brief Sets the number of samples used to compute the spectral properties
+         * FractionalDelayAndSum, BeamBank, MVDR and GSC analyse frames of twice the number of frames per channel,
+         * with 50% overlap and a delay of one frame. The FFT size is never smaller than that frame, which is also the
+         * default.
          * @param nfft Number of samples of the FFT
          */
         void setFFTSize(std::size_t nfft);
 
+        /**
+         * @brief Sets the forgetting factor of the recursive estimation of the noise covariance used by MVDR.
+         * The covariance is only updated in frames that are not of type FrameType::Voice, with an effective memory
+         * of about 1 / (1 - factor) frames.
+         * @param factor Forgetting factor in the range (0, 1), 0.98 by default.
+         */
+        void setForgettingFactor(float factor);
+
+        /**
+         * @brief Re-initializes the block, clearing the noise statistics, the interference canceller of GSC and the
+         * overlap of the previous frames.
+         */
+        void reset();
+
         /**
          * @brief If enabled, the algorithm suppose the signal arrive sensors
          * at the same time
@@ -78,7 +163,7 @@ namespace score {
          * @param input Input buffer storing the audio samples.
          * @param output Output buffer storing the results of the beam-forming.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
 
     private:
         struct Pimpl;
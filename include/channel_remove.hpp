@@ -31,7 +31,14 @@ namespace score {
          * @param input Input buffer
          * @param output Output buffer
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Selects the channels that has not been invalidated without copying any sample
+         * @param input Input view
+         * @param output View referencing the remaining channels of the input
+         */
+        void process(const AudioBufferView& input, AudioBufferView& output);
 
         /**
          * @brief Returns the number of channels that has not been invalidated
@@ -26,7 +26,7 @@ namespace score {
          * @param input Input buffer storing the audio samples.
          * @param output Output buffer storing the results of the beam-forming.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
     private:
         struct Pimpl;
         std::unique_ptr<Pimpl> pimpl_;
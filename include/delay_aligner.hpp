@@ -0,0 +1,82 @@
+#ifndef SMARTCORE_DELAY_ALIGNER_HPP
+#define SMARTCORE_DELAY_ALIGNER_HPP
+
+#include <audio_buffer.hpp>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Estimates the bulk delay between the played and the recorded signals and aligns the played one.
+     *
+     * The delay is tracked by matching the binary spectra of short blocks of both signals, and the played signal
+     * is delayed through an internal ring buffer, so the echo canceller that follows only has to model the echo
+     * path instead of the latency of the audio devices and can run with a short filter.
+     *
+     * The applied delay keeps one block of headroom below the estimate, so that the played signal never arrives
+     * after its echo. The echo canceller should cover at least a couple of blocks besides the echo tail.
+     */
+    class DelayAligner {
+    public:
+
+        /**
+         * @brief Creates an aligner for the given configuration.
+         * @param sample_rate Sampling rate in Hz
+         * @param channels Number of channels of the played signal
+         * @param frame_size Number of samples to process at one time (should correspond to 10-20 ms)
+         * @param max_delay Maximum delay to compensate, in samples.
+         * @throws std::invalid_argument if the configuration is not valid.
+         */
+        DelayAligner(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t max_delay);
+
+        /**
+         * @brief Default destructor
+         */
+        ~DelayAligner();
+
+        /**
+         * @brief Returns the number of samples of the blocks used to estimate the delay, its resolution.
+         * @return Block size in samples.
+         */
+        std::size_t blockSize() const;
+
+        /**
+         * @brief Returns the maximum delay the aligner can compensate.
+         * @return Maximum delay in samples.
+         */
+        std::size_t maxDelay() const;
+
+        /**
+         * @brief Returns the delay currently applied to the played signal.
+         * @return Delay in samples.
+         */
+        std::size_t delay() const;
+
+        /**
+         * @brief Returns the quality of the last estimation of the delay.
+         * @return Value in the range [0, 1], the higher the more reliable.
+         */
+        float quality() const;
+
+        /**
+         * @brief Updates the estimation with a frame and returns the played signal aligned with the recorded one.
+         * @param recorded Signal from the microphones, with any number of channels.
+         * @param played Signal played to the speakers.
+         * @param aligned Returns the played signal delayed by delay() samples.
+         * @throws std::invalid_argument if the frames do not match the configured format.
+         */
+        void process(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& aligned);
+
+        /**
+         * @brief Re-initializes the block, clearing the estimation and the history of the played signal.
+         */
+        void reset();
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_DELAY_ALIGNER_HPP
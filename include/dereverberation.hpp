@@ -2,11 +2,13 @@
 #define SMARTCORE_DEREVERB_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
 
     class DeReverberation {
+    public:
 
         /**
          * @brief Creates a de-reverberation block
@@ -53,7 +55,15 @@ namespace score {
          * @param input Buffer storing the input audio samples.
          * @param output Buffer storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Each channel runs its own preprocessor, so the output does not depend on the pool.
+         * @note Short frames are processed serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
 
     private:
         struct Pimpl;
@@ -0,0 +1,187 @@
+#ifndef SMARTCORE_DIRECTION_TRACKER_HPP
+#define SMARTCORE_DIRECTION_TRACKER_HPP
+
+#include <audio_buffer_view.hpp>
+#include <functional>
+#include <memory>
+
+namespace score {
+
+    class DOA;
+    class SrpPhat;
+    class Music;
+
+    /**
+     * @brief Tracks the azimuth of several sources over time on top of a localization block.
+     *
+     * Every track runs a constant-velocity Kalman filter over the azimuth. In every frame the tracks are predicted,
+     * the observations of the localizer are assigned to the closest track inside its validation gate, and the
+     * observations left unassigned give birth to new tentative tracks. A track is confirmed after a few hits and
+     * dies after missing too many speech frames or after a period without observations.
+     *
+     * The localizer is only run on speech frames: frames of type FrameType::Noise, or frames rejected by an
+     * external VAD, only propagate the tracks. The cost of localization is then proportional to the ratio of speech
+     * in the signal instead of to its length.
+     */
+    class DirectionTracker {
+    public:
+
+        /**
+         * @brief Observed direction of a source.
+         */
+        struct Observation {
+            float azimuth;      /*!< Angle in the XY plane, measured from the X axis, in degrees */
+            float power;        /*!< Confidence of the observation given by the localizer */
+        };
+
+        /**
+         * @brief Tracked source.
+         */
+        struct Track {
+            std::size_t id;     /*!< Unique identifier of the track */
+            float azimuth;      /*!< Filtered azimuth in degrees: [0, 360) */
+            float velocity;     /*!< Angular velocity in degrees/sec */
+            float deviation;    /*!< Standard deviation of the azimuth in degrees */
+            std::size_t hits;   /*!< Number of observations assigned to the track */
+            double idle;        /*!< Time since the last observation, in seconds */
+        };
+
+        /**
+         * @brief Callable object filling the observations of a frame.
+         */
+        using Localizer = std::function<void(const AudioBufferView&, std::vector<Observation>&)>;
+
+        /**
+         * @brief Creates a tracker without localizer: observations are given with update().
+         */
+        DirectionTracker();
+
+        /**
+         * @brief Default destructor
+         */
+        ~DirectionTracker();
+
+        /**
+         * @brief Sets the block used to localize the sources in speech frames.
+         * @param localizer Callable object filling the observations of a frame.
+         */
+        void setLocalizer(const Localizer& localizer);
+
+        /**
+         * @brief Uses a DOA block as localizer, with one observation per frame.
+         * @param doa Block used to localize the sources. It must outlive the tracker.
+         */
+        void setLocalizer(DOA& doa);
+
+        /**
+         * @brief Uses a SRP-PHAT block as localizer, with one observation per frame.
+         * @param srp Block used to localize the sources. It must outlive the tracker.
+         */
+        void setLocalizer(SrpPhat& srp);
+
+        /**
+         * @brief Uses a MUSIC block as localizer, with one observation per estimated source.
+         * @param music Block used to localize the sources. It must outlive the tracker.
+         */
+        void setLocalizer(Music& music);
+
+        /**
+         * @brief Sets the standard deviation of the angular acceleration of the sources.
+         * @param deviation Deviation in degrees/sec^2, 20 by default.
+         */
+        void setProcessNoise(float deviation);
+
+        /**
+         * @brief Sets the standard deviation of the observations of the localizer.
+         * @param deviation Deviation in degrees, 5 by default.
+         */
+        void setMeasurementNoise(float deviation);
+
+        /**
+         * @brief Sets the size of the validation gate of the tracks.
+         * @param deviations Maximum normalized distance, in standard deviations, between a track and an observation.
+         */
+        void setGate(float deviations);
+
+        /**
+         * @brief Sets the number of observations needed to confirm a track.
+         * @param hits Number of observations, 3 by default.
+         */
+        void setConfirmation(std::size_t hits);
+
+        /**
+         * @brief Sets the conditions that end a track.
+         * @param misses Number of consecutive speech frames without observations, 25 by default.
+         * @param timeout Time without observations in seconds, 5 by default.
+         */
+        void setTermination(std::size_t misses, double timeout);
+
+        /**
+         * @brief Sets the maximum number of simultaneous tracks, 4 by default.
+         * @param tracks Number of tracks.
+         */
+        void setMaximumTracks(std::size_t tracks);
+
+        /**
+         * @brief Sets the minimum power of an observation to give birth to a new track.
+         * @param power Minimum power, 0 by default.
+         */
+        void setBirthThreshold(float power);
+
+        /**
+         * @brief Propagates the tracks and, if the frame is not of type FrameType::Noise, localizes the sources
+         * and updates the tracks with them.
+         * @param input Frame with one channel per microphone.
+         * @return Confirmed tracks.
+         */
+        const std::vector<Track>& process(const AudioBufferView& input);
+
+        /**
+         * @brief Propagates the tracks and, if the frame contains speech, localizes the sources and updates the
+         * tracks with them.
+         * @param input Frame with one channel per microphone.
+         * @param speech Result of a VAD for the frame.
+         * @return Confirmed tracks.
+         */
+        const std::vector<Track>& process(const AudioBufferView& input, bool speech);
+
+        /**
+         * @brief Propagates the tracks and updates them with the given observations.
+         * @param observations Directions observed in the current frame.
+         * @param elapsed Time since the previous frame in seconds.
+         * @return Confirmed tracks.
+         */
+        const std::vector<Track>& update(const std::vector<Observation>& observations, double elapsed);
+
+        /**
+         * @brief Propagates the tracks without observations, as in a non-speech frame.
+         * @param elapsed Time since the previous frame in seconds.
+         * @return Confirmed tracks.
+         */
+        const std::vector<Track>& predict(double elapsed);
+
+        /**
+         * @brief Returns the confirmed tracks.
+         * @return Confirmed tracks, sorted by identifier.
+         */
+        const std::vector<Track>& tracks() const;
+
+        /**
+         * @brief Returns the number of frames in which the localizer has been run.
+         * @return Number of frames.
+         */
+        std::size_t localizations() const;
+
+        /**
+         * @brief Re-initializes the block, clearing all state.
+         */
+        void reset();
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_DIRECTION_TRACKER_HPP
@@ -1,7 +1,9 @@
 #ifndef SMARTCORE_DOA_H
 #define SMARTCORE_DOA_H
 
+#include <array_geometry.hpp>
 #include <audio_buffer.hpp>
+#include <gcc_phat.hpp>
 #include <memory>
 
 namespace score {
@@ -10,14 +12,24 @@ namespace score {
     public:
 
         /**
-         * @brief Build a block to compute the Direction of Arrival of an array of microphones.
+         * @brief Build a block to compute the Direction of Arrival of a uniform circular array of microphones.
          * @param sample_rate Sampling rate in Hz.
-         * @param microphone_distances Distances between microphones.
+         * @param num_microphones Number of microphones.
+         * @param microphone_distances Distance between opposite microphones, the diameter of the array.
          * @param sound_speed Sound of the speed in m/sec.
+         * @see ArrayGeometry::Circular
          */
         explicit DOA(std::int32_t sample_rate, std::uint8_t num_microphones,
                 float microphone_distances = 0.08127, float sound_speed = 343.2f);
 
+        /**
+         * @brief Build a block to compute the Direction of Arrival of an array of microphones.
+         * @param sample_rate Sampling rate in Hz.
+         * @param geometry Geometry of the array, with the microphones in the same order as the channels.
+         * @param sound_speed Sound of the speed in m/sec.
+         */
+        DOA(std::int32_t sample_rate, const ArrayGeometry& geometry, float sound_speed = 343.2f);
+
         /**
          * @brief Default destructor
          */
@@ -47,6 +59,27 @@ namespace score {
          */
         void setSoundSpeed(float speed);
 
+        /**
+         * @brief Returns the geometry of the array.
+         * @return Geometry of the array.
+         */
+        const ArrayGeometry& geometry() const;
+
+        /**
+         * @brief Sets the resolution of the azimuth grid in which the direction of arrival is searched.
+         * The delays expected for every direction are precomputed, so a finer grid only costs memory.
+         * @param degrees Step of the grid in degrees, 1 degree by default.
+         */
+        void setResolution(float degrees);
+
+        /**
+         * @brief Sets the method used to estimate delays between samples.
+         * Refining the delays recovers at 16 kHz an angular resolution similar to the one at 48 kHz without
+         * interpolation. By default, the delays are refined with a parabolic interpolation.
+         * @param interpolation Interpolation method.
+         */
+        void setInterpolation(GccPhat::Interpolation interpolation);
+
         /**
          * @brief Sets the group of microphones, given by pair of indexes
          * @param microphone_groups Group of microphones
@@ -59,13 +92,47 @@ namespace score {
          */
         const std::vector<std::pair<std::size_t, std::size_t>>& groupMicrophones() const;
 
+        /**
+         * @brief Returns every pair of microphones of an array, to be used as group of microphones.
+         * @param num_microphones Number of microphones.
+         * @return The num_microphones * (num_microphones - 1) / 2 pairs of microphones.
+         */
+        static std::vector<std::pair<std::size_t, std::size_t>> AllPairs(std::uint8_t num_microphones);
+
+        /**
+         * @brief Estimates the time delay of arrival between the microphones of every group.
+         *
+         * Each channel is transformed once per frame and all the groups are computed from the cached spectra, so
+         * the cost grows with the number of microphones rather than with the number of groups.
+         *
+         * @param microphone_inputs Frame with one channel per microphone.
+         * @return Delay in seconds of the first microphone of every group with respect to the second one.
+         */
+        const Vector<float>& estimateDelays(const AudioBufferView& microphone_inputs);
+
+        /**
+         * @brief Returns the delays estimated in the last frame.
+         * @return Delay in seconds of the first microphone of every group with respect to the second one.
+         */
+        const Vector<float>& delays() const;
+
+        /**
+         * @brief Returns the confidence of the delays estimated in the last frame.
+         * @return Average over the groups of the PHAT-weighted correlation at the estimated delay, about 1 for a
+         * single coherent source and close to 0 for diffuse noise.
+         */
+        float confidence() const;
+
         /**
          * @brief Computes the direction of arrival of the different microphones
          *
+         * The direction is the one of the azimuth grid whose expected delays are the closest, in the least-squares
+         * sense, to the delays estimated in every group of microphones.
+         *
          * @param input Vector of arrays storing the input audio samples.
-         * @returns The direction of arrival.
+         * @returns The direction of arrival: azimuth in degrees in the range [0, 360), measured from the X axis.
          */
-        float process(const AudioBuffer& microphone_inputs);
+        float process(const AudioBufferView& microphone_inputs);
 
         /**
          * @brief Re-initializes the block, clearing all state.
@@ -8,25 +8,73 @@ namespace score {
 
     class Encoder {
     public:
+
+        /**
+         * @brief The Mode enum describes where the samples are written to the disk.
+         */
+        enum Mode {
+            Synchronous = 0, /*!< The samples are written in the calling thread */
+            Asynchronous     /*!< The samples are queued and written in batches by a background thread */
+        };
+
         /**
          * @brief Encodes AudioBuffer in to the given file in  WAV format.
          * @param file Path of the audio file.
          * @param sample_rate Sampling frequency in Hz
          * @param channels Number of channels.
+         * @param mode Operation mode.
+         * @param queue_duration Duration in msecs of the queue used in the asynchronous mode.
          */
-        Encoder(const std::string& file, std::int32_t sample_rate, std::int8_t channels);
+        Encoder(const std::string& file, std::int32_t sample_rate, std::int8_t channels,
+                Mode mode = Mode::Synchronous, std::size_t queue_duration = 2000);
 
         /**
          * @brief Default destructor.
+         * @note The pending samples are written and synchronized before closing the file.
          */
         ~Encoder();
 
+        /**
+         * @brief Returns the operation mode.
+         * @return Operation mode.
+         */
+        Mode mode() const;
+
+        /**
+         * @brief Sets the interval between two consecutive synchronizations of the file with the disk.
+         * @param milliseconds Interval in msecs. A value of 0 synchronizes the file after every write.
+         * @note Defaults to 0 in synchronous mode and to 1000 msecs in asynchronous mode.
+         */
+        void setSyncInterval(std::size_t milliseconds);
+
+        /**
+         * @brief Returns the interval between two consecutive synchronizations of the file with the disk.
+         * @return Interval in msecs.
+         */
+        std::size_t syncInterval() const;
+
+        /**
+         * @brief Returns the number of frames dropped because the queue was full.
+         * @note Only the asynchronous mode may drop frames.
+         * @return Number of dropped frames (samples per channel).
+         */
+        std::size_t droppedFrames() const;
+
+        /**
+         * @brief Writes all the pending samples and synchronizes the file with the disk.
+         * @note In asynchronous mode, it blocks until the background thread empties the queue.
+         */
+        void flush();
+
         /**
          * @brief Encodes the AudioBuffer in the audio file.
          *
+         * In asynchronous mode the samples are only copied into a preallocated queue, so this function never
+         * waits for the disk.
+         *
          * @param input Buffer storing the input audio samples.
          */
-        void process(const AudioBuffer& input);
+        void process(const AudioBufferView& input);
 
     private:
         struct Pimpl;
@@ -2,12 +2,13 @@
 #define SMARTCORE_FILTER_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
 
     class Filter {
-    private:
+    public:
 
         /**
         * @brief The filter_type enum defines the different available filters.
@@ -153,7 +154,14 @@ namespace score {
          * @param input Buffer storing the input audio samples.
          * @param output Buffer storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Short frames are filtered serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
 
     private:
         struct Pimpl;
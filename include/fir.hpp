@@ -7,6 +7,7 @@
 namespace score {
     
     class FIR {
+    public:
 
         /**
          * @brief Creates a FIR filter with the given coefficients
@@ -39,7 +40,7 @@ namespace score {
          * @param input Buffer storing the input audio samples.
          * @param output Buffer storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
         
     private:
         struct Pimpl;
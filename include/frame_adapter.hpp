@@ -0,0 +1,77 @@
+#ifndef SMARTCORE_FRAME_ADAPTER_HPP
+#define SMARTCORE_FRAME_ADAPTER_HPP
+
+#include <audio_buffer.hpp>
+#include <functional>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Re-blocks a stream of frames of any size in to frames of a fixed size.
+     *
+     * The incoming samples are accumulated in a preallocated buffer and a frame is delivered to the listener every
+     * time it is complete, so the added latency is bounded by the duration of one output frame.
+     */
+    class FrameAdapter {
+    public:
+
+        /**
+         * @brief Creates a FrameAdapter with the given configuration
+         * @param sample_rate Sampling frequency in Hz
+         * @param channels Number of channels
+         * @param frames_per_channel Number of samples per channel of the output frames.
+         */
+        FrameAdapter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel);
+
+        /**
+         * @brief Creates a FrameAdapter delivering frames of the given duration.
+         * @param sample_rate Sampling frequency in Hz
+         * @param channels Number of channels
+         * @param duration Duration in msecs of the output frames.
+         * @return FrameAdapter with the given configuration.
+         */
+        static std::unique_ptr<FrameAdapter> FromDuration(std::int32_t sample_rate, std::int8_t channels,
+                std::size_t duration);
+
+        /**
+         * @brief Default destructor
+         */
+        ~FrameAdapter();
+
+        /**
+         * @brief Updates the listener that may be called when an output frame is complete.
+         * @param callback Callback to be called.
+         */
+        void setOnFrameReady(const std::function<void(AudioBuffer& frame)>& callback);
+
+        /**
+         * @brief Accumulates the samples of the input frame, delivering all the output frames completed.
+         * @param input Input frame.
+         */
+        void process(const AudioBufferView& input);
+
+        /**
+         * @brief Discards the accumulated samples.
+         */
+        void reset();
+
+        /**
+         * @brief Returns the number of samples per channel of the output frames.
+         * @return Number of samples per channel.
+         */
+        std::size_t framesPerChannel() const;
+
+        /**
+         * @brief Returns the number of samples per channel waiting for the next output frame.
+         * @return Number of accumulated samples per channel.
+         */
+        std::size_t pending() const;
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+}
+
+#endif //SMARTCORE_FRAME_ADAPTER_HPP
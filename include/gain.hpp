@@ -37,7 +37,7 @@ namespace score {
          * @param input Buffer storing the input audio samples.
          * @param output Buffer storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
 
     private:
         struct Pimpl;
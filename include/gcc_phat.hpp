@@ -0,0 +1,117 @@
+#ifndef SMARTCORE_GCC_PHAT_HPP
+#define SMARTCORE_GCC_PHAT_HPP
+
+#include <audio_buffer.hpp>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Generalized Cross Correlation with Phase Transform (GCC-PHAT) between the channels of a frame.
+     *
+     * The channels are zero-padded to a power of two of at least twice the frame length, so the estimated
+     * correlation is linear rather than circular, and transformed with real-to-complex FFTW plans (see RealFFT).
+     * The workspace is preallocated, so processing a frame does not allocate memory and several instances can run
+     * concurrently on different threads.
+     */
+    class GccPhat {
+    public:
+
+        /**
+         * @brief Method used to estimate the delay between the samples of the cross correlation.
+         */
+        enum Interpolation {
+            None,           /*!< The delay is the lag of the maximum */
+            Parabolic,      /*!< Fits a parabola through the maximum and its two neighbours */
+            BandLimited     /*!< Upsamples the correlation around the maximum with a windowed sinc kernel */
+        };
+
+        /**
+         * @brief Maximum of the cross correlation between two channels.
+         */
+        struct Peak {
+            std::int32_t lag;   /*!< Delay in samples of the channel with respect to the reference */
+            float value;        /*!< Normalized correlation at the given lag */
+            float delay;        /*!< Delay in samples, refined with the configured interpolation */
+        };
+
+        /**
+         * @brief Creates an estimator with the given configuration.
+         * @param channels Number of channels of the input frames.
+         * @param frames_per_channel Number of samples per channel of the input frames.
+         * @throws std::invalid_argument if the number of channels or samples is zero.
+         */
+        GccPhat(std::int8_t channels, std::size_t frames_per_channel);
+
+        /**
+         * @brief Default destructor
+         */
+        ~GccPhat();
+
+        /**
+         * @brief Returns the number of channels of the input frames.
+         * @return Number of channels.
+         */
+        std::int8_t channels() const;
+
+        /**
+         * @brief Returns the number of samples per channel of the input frames.
+         * @return Number of samples per channel.
+         */
+        std::size_t framesPerChannel() const;
+
+        /**
+         * @brief Returns the size of the FFT, the length of the cross correlation.
+         * @return Number of points of the FFT.
+         */
+        std::size_t fftSize() const;
+
+        /**
+         * @brief Returns the method used to refine the delay between samples.
+         * @return Interpolation method.
+         */
+        Interpolation interpolation() const;
+
+        /**
+         * @brief Sets the method used to refine the delay between samples.
+         *
+         * The parabolic fit is almost free but biased towards the closest integer lag. The band-limited one
+         * upsamples by 8 the correlation within one sample of the maximum with a 16-tap Lanczos kernel, so it is
+         * more accurate at a fixed cost of a few hundred operations per pair, independent of the size of the FFT.
+         *
+         * @param interpolation Interpolation method.
+         */
+        void setInterpolation(Interpolation interpolation);
+
+        /**
+         * @brief Computes and caches the spectrum of every channel of the frame.
+         * @param input Input frame, any stride is supported.
+         * @throws std::invalid_argument if the frame does not match the configured format.
+         */
+        void analyze(const AudioBufferView& input);
+
+        /**
+         * @brief Computes the cross correlation between a channel and a reference channel from the cached spectra.
+         * @param channel Index of the delayed channel.
+         * @param reference Index of the reference channel.
+         * @param margin Maximum delay searched, in samples.
+         * @return Maximum of the cross correlation in the range [-margin, margin].
+         * @throws std::invalid_argument if the channels or the margin are out of range.
+         */
+        Peak correlate(std::size_t channel, std::size_t reference, std::int32_t margin);
+
+        /**
+         * @brief Returns the cross correlation computed in the last call to correlate.
+         * The correlation is circular: the value at the lag k is stored at the index k modulo fftSize.
+         * @return Pointer to the fftSize values of the correlation.
+         */
+        const float* correlation() const;
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_GCC_PHAT_HPP
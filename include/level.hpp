@@ -24,7 +24,7 @@ namespace score {
          * @param input Vector storing the input audio samples.
          * @return Vector of the levels at each channel
          */
-        const Vector<float> & process(const AudioBuffer& input);
+        const Vector<float> & process(const AudioBufferView& input);
 
         /**
          * @brief Returns the computed level for each channel
@@ -2,6 +2,7 @@
 #define SMARTCORE_LOW_CUT_FILTER_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
@@ -25,7 +26,14 @@ namespace score {
          * @param input Vector storing the input audio samples.
          * @param output Vector storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Short frames are filtered serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
 
     private:
         struct Pimpl;
@@ -0,0 +1,128 @@
+#ifndef SMARTCORE_MUSIC_HPP
+#define SMARTCORE_MUSIC_HPP
+
+#include <array_geometry.hpp>
+#include <audio_buffer.hpp>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Wideband MUltiple SIgnal Classification (MUSIC) direction of arrival estimator.
+     *
+     * The spatial covariance matrix of every frequency bin in the analysed band is updated recursively with the
+     * spectrum of each frame (a rank-one update with a forgetting factor), instead of being re-estimated from a
+     * block of frames. The noise subspaces are only re-computed every few frames, or earlier if the covariance
+     * matrices drift away from the last decomposed ones, and the pseudo-spectrum is only re-evaluated after a
+     * decomposition, so the per-frame cost is bounded by the covariance updates. The narrowband pseudo-spectra are
+     * combined incoherently over the band, and the strongest peaks are reported as sources.
+     *
+     * Arrays of 2, 4, 6 and 8 microphones use fixed-size matrices.
+     */
+    class Music {
+    public:
+
+        /**
+         * @brief Estimated source.
+         */
+        struct Source {
+            float azimuth;      /*!< Angle in the XY plane, measured from the X axis, in degrees: [0, 360) */
+            float power;        /*!< Value of the pseudo-spectrum at the given azimuth */
+        };
+
+        /**
+         * @brief Creates an estimator for the given array of microphones.
+         * @param sample_rate Sampling rate in Hz.
+         * @param frames_per_channel Number of samples per channel of the input frames.
+         * @param microphones Geometry of the array, with the microphones in the same order as the channels.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @throws std::invalid_argument if there are less than two microphones.
+         */
+        Music(std::int32_t sample_rate, std::size_t frames_per_channel,
+              const ArrayGeometry& microphones, float sound_speed = 343.2f);
+
+        /**
+         * @brief Default destructor
+         */
+        ~Music();
+
+        /**
+         * @brief Returns the number of sources searched.
+         * @return Number of sources.
+         */
+        std::size_t sources() const;
+
+        /**
+         * @brief Sets the number of sources searched, the dimension of the signal subspace.
+         * @param sources Number of sources.
+         * @throws std::invalid_argument if the number is zero or not smaller than the number of microphones.
+         */
+        void setSources(std::size_t sources);
+
+        /**
+         * @brief Sets the forgetting factor of the recursive covariance estimation.
+         * The effective memory of the estimation is about 1 / (1 - factor) frames.
+         * @param factor Forgetting factor in the range (0, 1).
+         */
+        void setForgettingFactor(float factor);
+
+        /**
+         * @brief Sets the band of frequencies analysed.
+         * @param minimum Minimum frequency in Hz.
+         * @param maximum Maximum frequency in Hz.
+         * @throws std::invalid_argument if the band does not contain any frequency bin.
+         */
+        void setFrequencyRange(float minimum, float maximum);
+
+        /**
+         * @brief Sets the maximum number of frames between two decompositions of the covariance matrices.
+         * @param frames Number of frames.
+         */
+        void setUpdateInterval(std::size_t frames);
+
+        /**
+         * @brief Sets the relative drift of the covariance matrices that triggers a new decomposition before the
+         * update interval expires.
+         * @param threshold Relative Frobenius distance to the last decomposed matrices.
+         */
+        void setDriftThreshold(float threshold);
+
+        /**
+         * @brief Sets the resolution of the azimuth grid.
+         * @param degrees Step of the grid in degrees.
+         */
+        void setResolution(float degrees);
+
+        /**
+         * @brief Returns the number of decompositions of the covariance matrices done so far.
+         * @return Number of decompositions.
+         */
+        std::size_t decompositions() const;
+
+        /**
+         * @brief Returns the pseudo-spectrum of the last decomposition, one value per direction of the grid.
+         * @return Pseudo-spectrum sorted by azimuth.
+         */
+        const Vector<float>& spectrum() const;
+
+        /**
+         * @brief Updates the covariance matrices with a frame and estimates the direction of the sources.
+         * @param input Frame with one channel per microphone.
+         * @return Up to sources() sources, sorted by decreasing power.
+         * @throws std::invalid_argument if the frame does not match the configured format.
+         */
+        const std::vector<Source>& process(const AudioBufferView& input);
+
+        /**
+         * @brief Re-initializes the block, clearing all state.
+         */
+        void reset();
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_MUSIC_HPP
@@ -24,7 +24,7 @@ namespace score {
          * @brief Estimates the average noise level (rms) in the audio frame.
          * @return Vector of the levels at each channel
          */
-        float process(const AudioBuffer& input);
+        float process(const AudioBufferView& input);
 
         /**
          * @brief Returns the average noise level of the processed frame.
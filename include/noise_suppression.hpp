@@ -2,6 +2,7 @@
 #define SMARTCORE_NOISE_SUPPRESSION_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
@@ -68,7 +69,15 @@ namespace score {
          * @param input Vector storing the input audio samples.
          * @param output Vector storing the output audio samples.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Each channel has its own state, so the output does not depend on the pool.
+         * @note Short frames are processed serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
 
     private:
         struct Pimpl;
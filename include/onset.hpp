@@ -135,7 +135,7 @@ namespace score {
          * @param samples Vector with the audio samples.
          * @return Pair holding the state of the detection and the moment where the onset was detected in msecs.
          */
-        std::pair<bool, float> process(const AudioBuffer& input);
+        std::pair<bool, float> process(const AudioBufferView& input);
 
 
     private:
@@ -0,0 +1,279 @@
+#ifndef SMARTCORE_PIPELINE_HPP
+#define SMARTCORE_PIPELINE_HPP
+
+#include <audio_buffer.hpp>
+#include <profiler.hpp>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+
+namespace score {
+
+    /**
+     * @brief Processing graph connecting blocks through preallocated intermediate buffers.
+     *
+     * Every stage reads the output of a parent stage (or of a source of the pipeline) and can feed any number of
+     * child stages. Combining stages, such as an echo canceller, read a second reference stage as well, which is
+     * usually an additional source fed with feed() before every frame. Since a stage can only read the stages added
+     * before it, the graph is acyclic and stages are executed in the order they were added. The format of every
+     * stage is inferred once in build(), which also allocates the intermediate buffers: a buffer is reused as soon as
+     * all the consumers of its stage have run, so a chain of blocks ping-pongs between two buffers, and stages marked
+     * as in-place write directly in the buffer of their parent. Once built, processing a frame does not allocate
+     * memory.
+     */
+    class Pipeline {
+    public:
+
+        /**
+         * @brief Identifier of a stage in the pipeline.
+         */
+        using Stage = std::size_t;
+
+        /**
+         * @brief Stage representing the input of the pipeline.
+         */
+        static constexpr Stage Source = 0;
+
+        /**
+         * @brief Refers to the last stage added to the pipeline.
+         */
+        static constexpr Stage Previous = std::numeric_limits<Stage>::max();
+
+        /**
+         * @brief Describes the frames produced by a stage.
+         */
+        struct Format {
+            std::int32_t sample_rate;
+            std::int8_t channels;
+            std::size_t frames_per_channel;
+        };
+
+        /**
+         * @brief Function transforming the input frame of a stage in to its output frame.
+         */
+        using Process = std::function<void(const AudioBufferView& input, AudioBuffer& output)>;
+
+        /**
+         * @brief Function transforming the input frame of a stage and a reference frame into its output frame.
+         */
+        using Combine = std::function<void(const AudioBufferView& input, const AudioBufferView& reference,
+                                           AudioBuffer& output)>;
+
+        /**
+         * @brief Function consuming the input frame of a stage without producing any output.
+         */
+        using Consume = std::function<void(const AudioBufferView& input)>;
+
+        /**
+         * @brief Function computing the output format of a stage from its input format.
+         */
+        using Shape = std::function<Format(const Format& input)>;
+
+        /**
+         * @brief Creates an empty pipeline.
+         * @param sample_rate Sample rate in Hz of the input frames.
+         * @param channels Number of channels of the input frames.
+         * @param frames_per_channel Number of samples per channel of the input frames.
+         */
+        Pipeline(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel);
+
+        /**
+         * @brief Default destructor
+         */
+        ~Pipeline();
+
+        /**
+         * @brief Adds a stage transforming the frames of its parent.
+         * @param name Name of the stage.
+         * @param process Function processing the frames.
+         * @param parent Stage providing the input frames.
+         * @param shape Function computing the output format of the stage.
+         * @param in_place If true, the stage may write its output in the buffer of its input.
+         * @return Identifier of the new stage.
+         * @throws std::runtime_error if the pipeline is already built.
+         */
+        Stage add(const std::string& name, const Process& process, Stage parent = Previous,
+                  const Shape& shape = SameFormat(), bool in_place = false);
+
+        /**
+         * @brief Adds an additional source, whose frames are provided with feed() before every call to process().
+         * @param name Name of the stage.
+         * @param sample_rate Sample rate in Hz of the frames.
+         * @param channels Number of channels of the frames.
+         * @param frames_per_channel Number of samples per channel of the frames.
+         * @return Identifier of the new stage.
+         * @throws std::runtime_error if the pipeline is already built.
+         */
+        Stage source(const std::string& name, std::int32_t sample_rate, std::int8_t channels,
+                     std::size_t frames_per_channel);
+
+        /**
+         * @brief Adds a stage transforming the frames of its parent together with the frames of a reference stage,
+         * such as the far-end signal of an echo canceller.
+         * @param name Name of the stage.
+         * @param combine Function processing the frames.
+         * @param parent Stage providing the input frames.
+         * @param reference Stage providing the reference frames.
+         * @param shape Function computing the output format of the stage from the format of its parent.
+         * @return Identifier of the new stage.
+         * @throws std::runtime_error if the pipeline is already built.
+         */
+        Stage combine(const std::string& name, const Combine& combine, Stage parent, Stage reference,
+                      const Shape& shape = SameFormat());
+
+        /**
+         * @brief Adds a stage consuming the frames of its parent, such as an encoder or an estimator.
+         * @param name Name of the stage.
+         * @param consume Function consuming the frames.
+         * @param parent Stage providing the input frames.
+         * @return Identifier of the new stage.
+         * @throws std::runtime_error if the pipeline is already built.
+         */
+        Stage sink(const std::string& name, const Consume& consume, Stage parent = Previous);
+
+        /**
+         * @brief Adds a block transforming the frames of its parent.
+         * @note The pipeline does not take the ownership of the block.
+         * @param name Name of the stage.
+         * @param block Block implementing process(const AudioBufferView&, AudioBuffer&).
+         * @param parent Stage providing the input frames.
+         * @param shape Function computing the output format of the stage.
+         * @param in_place If true, the stage may write its output in the buffer of its input.
+         * @return Identifier of the new stage.
+         */
+        template <typename Block>
+        Stage addBlock(const std::string& name, Block& block, Stage parent = Previous,
+                       const Shape& shape = SameFormat(), bool in_place = false) {
+            return add(name, [&block](const AudioBufferView& input, AudioBuffer& output) {
+                block.process(input, output);
+            }, parent, shape, in_place);
+        }
+
+        /**
+         * @brief Adds a block transforming the frames of its parent together with the frames of a reference stage.
+         * @note The pipeline does not take the ownership of the block.
+         * @param name Name of the stage.
+         * @param block Block implementing process(const AudioBufferView&, const AudioBufferView&, AudioBuffer&).
+         * @param parent Stage providing the input frames.
+         * @param reference Stage providing the reference frames.
+         * @param shape Function computing the output format of the stage from the format of its parent.
+         * @return Identifier of the new stage.
+         */
+        template <typename Block>
+        Stage combineBlock(const std::string& name, Block& block, Stage parent, Stage reference,
+                           const Shape& shape = SameFormat()) {
+            return combine(name, [&block](const AudioBufferView& input, const AudioBufferView& reference,
+                                          AudioBuffer& output) {
+                block.process(input, reference, output);
+            }, parent, reference, shape);
+        }
+
+        /**
+         * @brief Adds a block consuming the frames of its parent.
+         * @note The pipeline does not take the ownership of the block.
+         * @param name Name of the stage.
+         * @param block Block implementing process(const AudioBufferView&).
+         * @param parent Stage providing the input frames.
+         * @return Identifier of the new stage.
+         */
+        template <typename Block>
+        Stage sinkBlock(const std::string& name, Block& block, Stage parent = Previous) {
+            return sink(name, [&block](const AudioBufferView& input) {
+                block.process(input);
+            }, parent);
+        }
+
+        /**
+         * @brief Infers the format of every stage and allocates the intermediate buffers.
+         * @note The topology of the pipeline can not be modified once built.
+         */
+        void build();
+
+        /**
+         * @brief Checks if the pipeline is ready to process frames.
+         * @return True if the pipeline is built, false otherwise.
+         */
+        bool isBuilt() const;
+
+        /**
+         * @brief Provides the next frame of an additional source.
+         * @note The frame is not copied, it must stay valid until the next call to process().
+         * @param source Stage returned by source().
+         * @param frame Frame of the source.
+         * @throws std::invalid_argument if the stage is not an additional source or the frame does not match its
+         * format.
+         */
+        void feed(Stage source, const AudioBufferView& frame);
+
+        /**
+         * @brief Processes a frame through all the stages of the pipeline.
+         * The pipeline is built in the first call if needed.
+         * @param input Input frame.
+         * @throws std::invalid_argument if the frame does not match the input format of the pipeline.
+         * @throws std::runtime_error if an additional source was not fed, or if a stage produces a frame with a
+         * different format than the inferred one.
+         */
+        void process(const AudioBufferView& input);
+
+        /**
+         * @brief Sets the profiler measuring every stage of the pipeline.
+         * A probe named after each stage is registered, plus a "pipeline" probe measuring the whole frame. The probes
+         * are registered only once per profiler, even if it is set again. The capture-to-output latency is recorded by
+         * the stages consuming frames.
+         * @param profiler Profiler recording the measurements, or nullptr to remove it.
+         */
+        void setProfiler(const std::shared_ptr<Profiler>& profiler);
+
+        /**
+         * @brief Returns the number of stages, including the source.
+         * @return Number of stages.
+         */
+        std::size_t stages() const;
+
+        /**
+         * @brief Returns the name of the given stage.
+         * @param stage Identifier of the stage.
+         * @return Name of the stage.
+         */
+        const std::string& name(Stage stage) const;
+
+        /**
+         * @brief Returns the format of the frames produced by the given stage.
+         * @note The format of the stages is only available once the pipeline is built.
+         * @param stage Identifier of the stage.
+         * @return Format of the output frames.
+         */
+        Format format(Stage stage) const;
+
+        /**
+         * @brief Returns the number of intermediate buffers allocated to run the pipeline.
+         * @return Number of buffers.
+         */
+        std::size_t buffers() const;
+
+        /**
+         * @brief Keeps the format of the input frames.
+         */
+        static Shape SameFormat();
+
+        /**
+         * @brief Changes the number of channels of the input frames.
+         * @param channels Number of channels of the output frames.
+         */
+        static Shape ChannelsFormat(std::int8_t channels);
+
+        /**
+         * @brief Changes the sample rate of the input frames, scaling the number of samples per channel.
+         * @param sample_rate Sample rate in Hz of the output frames.
+         */
+        static Shape SampleRateFormat(std::int32_t sample_rate);
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_PIPELINE_HPP
@@ -85,7 +85,7 @@ namespace score {
          * @param samples Vector with the audio samples.
          * @return Pair holding the estimated pitch and the current confidence of the pitch algorithm.
          */
-        std::pair<float, float> process(const AudioBuffer& input);
+        std::pair<float, float> process(const AudioBufferView& input);
 
     private:
         struct Pimpl;
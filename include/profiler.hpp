@@ -0,0 +1,184 @@
+#ifndef SMARTCORE_PROFILER_HPP
+#define SMARTCORE_PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace score {
+
+    /**
+     * @brief Collects per-block timing statistics of a processing chain.
+     *
+     * Every block registers a probe once, during the setup of the chain. Afterwards, the wall and CPU time of
+     * each call, the capture-to-output latency and the dropped frames are accumulated in lock-free histograms,
+     * so recording from the audio threads never locks nor allocates. When the profiler is disabled, recording
+     * costs a single relaxed atomic load.
+     */
+    class Profiler {
+    public:
+
+        /**
+         * @brief Identifier of a registered block.
+         */
+        using Probe = std::size_t;
+
+        /**
+         * @brief Summary of a distribution, in microseconds.
+         */
+        struct Distribution {
+            double p50;
+            double p99;
+            double max;
+        };
+
+        /**
+         * @brief Statistics of a registered block.
+         */
+        struct Statistics {
+            std::string name;
+            std::uint64_t frames;
+            std::uint64_t dropped;
+            Distribution wall;
+            Distribution cpu;
+            Distribution latency;
+        };
+
+        /**
+         * @brief Measures the wall and CPU time spent in a scope and records it in the given probe.
+         * Nothing is measured if the profiler is disabled when the scope is entered.
+         */
+        class Scope {
+        public:
+            Scope(Profiler& profiler, Probe probe) :
+                profiler_(profiler.isEnabled() ? &profiler : nullptr),
+                probe_(probe) {
+                if (profiler_ != nullptr) {
+                    wall_ = WallTime();
+                    cpu_ = CpuTime();
+                }
+            }
+
+            ~Scope() {
+                if (profiler_ != nullptr) {
+                    profiler_->recordTime(probe_, WallTime() - wall_, CpuTime() - cpu_);
+                }
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Profiler* profiler_;
+            Probe probe_;
+            std::int64_t wall_{0};
+            std::int64_t cpu_{0};
+        };
+
+        /**
+         * @brief Creates a profiler.
+         * @param enabled If true, the measurements are recorded.
+         */
+        explicit Profiler(bool enabled = false);
+
+        /**
+         * @brief Default destructor
+         */
+        ~Profiler();
+
+        /**
+         * @brief Registers a block.
+         * @note This function is not thread-safe, the blocks should be registered while setting up the chain.
+         * @param name Name of the block.
+         * @return Identifier of the block.
+         */
+        Probe registerBlock(const std::string& name);
+
+        /**
+         * @brief Enables or disables the recording of measurements.
+         * @param enabled If true, the measurements are recorded.
+         */
+        void setEnabled(bool enabled) {
+            enabled_.store(enabled, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Checks if the measurements are being recorded.
+         * @return True if the profiler is enabled, false otherwise.
+         */
+        bool isEnabled() const {
+            return enabled_.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Sets the clock used to compute the capture-to-output latency.
+         * The clock must return the current time in seconds in the same time base as AudioBuffer::timestamp,
+         * i.e Recorder::timestamp.
+         * @param clock Function returning the current time in seconds.
+         */
+        void setClock(const std::function<double()>& clock);
+
+        /**
+         * @brief Records the duration of a call of the given block.
+         * @param probe Identifier of the block.
+         * @param wall_ns Wall time in nanoseconds.
+         * @param cpu_ns CPU time in nanoseconds.
+         */
+        void recordTime(Probe probe, std::int64_t wall_ns, std::int64_t cpu_ns);
+
+        /**
+         * @brief Records the latency of a frame leaving the given block.
+         * @note Nothing is recorded if there is no clock.
+         * @param probe Identifier of the block.
+         * @param timestamp Time in seconds when the first sample of the frame was captured.
+         */
+        void recordLatency(Probe probe, double timestamp);
+
+        /**
+         * @brief Records frames dropped by the given block.
+         * @param probe Identifier of the block.
+         * @param frames Number of dropped frames.
+         */
+        void recordDropped(Probe probe, std::uint64_t frames);
+
+        /**
+         * @brief Returns the statistics of all the registered blocks.
+         * @return Statistics of every block, in registration order.
+         */
+        std::vector<Statistics> snapshot() const;
+
+        /**
+         * @brief Returns the statistics of all the registered blocks as a JSON document.
+         * @return JSON document.
+         */
+        std::string toJson() const;
+
+        /**
+         * @brief Clears all the measurements, keeping the registered blocks.
+         */
+        void reset();
+
+        /**
+         * @brief Returns the current monotonic time.
+         * @return Time in nanoseconds.
+         */
+        static std::int64_t WallTime();
+
+        /**
+         * @brief Returns the CPU time consumed by the calling thread.
+         * @return Time in nanoseconds.
+         */
+        static std::int64_t CpuTime();
+
+    private:
+        std::atomic<bool> enabled_;
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_PROFILER_HPP
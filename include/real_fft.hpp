@@ -0,0 +1,66 @@
+#ifndef SMARTCORE_REAL_FFT_HPP
+#define SMARTCORE_REAL_FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Fast Fourier Transform of real signals, backed by FFTW.
+     *
+     * The FFTW plans are shared between all the instances with the same size. They are created once, under a lock
+     * because the FFTW planner is not reentrant, and executed on the caller's arrays, so several instances can
+     * transform concurrently on different threads without allocating memory.
+     */
+    class RealFFT {
+    public:
+
+        /**
+         * @brief Creates a transform of the given size.
+         * @param size Number of real samples.
+         * @throws std::invalid_argument if the size is zero.
+         */
+        explicit RealFFT(std::size_t size);
+
+        /**
+         * @brief Default destructor
+         */
+        ~RealFFT();
+
+        /**
+         * @brief Returns the number of real samples of the transform.
+         * @return Size of the transform.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Returns the number of non-redundant complex bins of the spectrum.
+         * @return size / 2 + 1
+         */
+        std::size_t bins() const;
+
+        /**
+         * @brief Computes the spectrum of a real signal.
+         * @param input Array of size() samples, not modified.
+         * @param output Array of bins() complex values.
+         */
+        void forward(const float* input, std::complex<float>* output);
+
+        /**
+         * @brief Computes the real signal of a spectrum.
+         * @note The result is not normalized: it is scaled by size().
+         * @param input Array of bins() complex values, not modified.
+         * @param output Array of size() samples.
+         */
+        void inverse(const std::complex<float>* input, float* output);
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_REAL_FFT_HPP
@@ -17,6 +17,12 @@ namespace score {
             double defaultSampleRate;
         } ;
 
+        struct QueueStatistics {
+            std::size_t overflows;  /*!< Buffers dropped because the queue was full */
+            std::size_t underflows; /*!< Times the processing thread starved waiting for a new buffer */
+            std::size_t peak;       /*!< Maximum number of buffers waiting in the queue */
+        };
+
         /**
          * @brief Returns the default information about a device
          * @param index Index of the device
@@ -90,9 +96,10 @@ namespace score {
 
         /**
          * @brief Returns the current time in seconds for a stream according to the system clock.
+         * @note The recorded frames are stamped in the same time base, so it can be used as the clock of a Profiler.
          * @return The stream's current time in seconds, or 0 if an error occurred.
          */
-        float timestamp() const;
+        double timestamp() const;
 
         /**
          * @brief Returns the stream sample rate.
@@ -115,6 +122,7 @@ namespace score {
         /**
          * @brief Set the number of frames per buffer.
          * @param number Number of frames per buffer.
+         * @throws std::runtime_error if the stream is recording.
          */
         void setFramesPerBuffer(std::size_t number);
 
@@ -154,6 +162,42 @@ namespace score {
          */
         void setOnProcessingBufferReady(const std::function<void(AudioBuffer& buffer)>& callback);
 
+        /**
+         * @brief Updates the listener that may be called with a view over the interleaved samples of the sound
+         * card when a frame is ready to be processed. Unlike setOnProcessingBufferReady, the samples are not
+         * copied nor deinterleaved.
+         * @note The view is only valid during the call.
+         * @param callback Callback to be called.
+         */
+        void setOnProcessingViewReady(const std::function<void(AudioBufferView& view)>& callback);
+
+        /**
+         * @brief Enables or disables the asynchronous mode.
+         *
+         * In asynchronous mode, the audio callback only pushes the raw interleaved samples into a preallocated
+         * lock-free queue. The buffers are deinterleaved and delivered to the listener set with
+         * setOnProcessingBufferReady from a dedicated processing thread, so the processing chain never runs
+         * in the audio thread.
+         *
+         * @param enabled If true, the buffers are delivered from the processing thread.
+         * @param queue_size Maximum number of buffers waiting to be processed.
+         * @throws std::runtime_error if the stream is active.
+         */
+        void setAsynchronous(bool enabled, std::size_t queue_size = 16);
+
+        /**
+         * @brief Checks if the buffers are delivered from the processing thread.
+         * @return True if the asynchronous mode is enabled, false otherwise.
+         */
+        bool isAsynchronous() const;
+
+        /**
+         * @brief Returns the overflow/underflow counters of the capture queue.
+         * @note The counters are only updated in asynchronous mode.
+         * @return Statistics of the capture queue.
+         */
+        QueueStatistics queueStatistics() const;
+
         /**
          * @brief Re-initializes the block, clearing all state.
          * @note This function should be called after any modification in the streaming.
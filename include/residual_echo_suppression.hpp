@@ -2,6 +2,7 @@
 #define SMARTCORE_RESIDUAL_ECHO_SUPPRESSION_HPP
 
 #include <audio_buffer.hpp>
+#include <thread_pool.hpp>
 #include <memory>
 
 namespace score {
@@ -14,6 +15,9 @@ namespace score {
          * @param sample_rate Sampling rate in Hz
          * @param channels Number of channels
          * @param frames_per_buffer Number of samples to process at one time (should correspond to 10-20 ms)
+         *
+         * @note The residual echo is estimated by a Speex echo canceller, which this block is not linked to. Use a
+         * SpeexPreprocessor with the EchoSuppression feature and SpeexPreprocessor::setEchoCanceller instead.
          */
         ResidualEchoSuppression(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_buffer);
 
@@ -53,7 +57,15 @@ namespace score {
          * @param recorded Input buffer
          * @param output Output buffer
          */
-        void process(const AudioBuffer& recorded, AudioBuffer& output);
+        void process(const AudioBufferView& recorded, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Each channel runs its own preprocessor, so the output does not depend on the pool.
+         * @note Short frames are processed serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
 
     private:
         struct Pimpl;
@@ -155,7 +155,7 @@ namespace score {
          * @param recorded Input buffer
          * @param output Output buffer
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
 
     private:
         struct Pimpl;
@@ -0,0 +1,163 @@
+#ifndef SMARTCORE_RING_BUFFER_HPP
+#define SMARTCORE_RING_BUFFER_HPP
+
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+
+namespace score {
+
+    /**
+     * @brief Lock-free single-producer/single-consumer ring buffer.
+     *
+     * All the memory is allocated at construction, so writing and reading never allocate, lock or block.
+     * It is safe to call the write functions from one thread (i.e the audio callback) and the read functions
+     * from another one, as long as each side is only used by a single thread.
+     */
+    template <typename T>
+    class RingBuffer {
+    public:
+
+        /**
+         * @brief Creates a ring buffer able to hold the given number of elements.
+         * @param capacity Maximum number of elements stored in the buffer.
+         */
+        explicit RingBuffer(std::size_t capacity = 0) :
+            data_(capacity) {
+
+        }
+
+        /**
+         * @brief Returns the maximum number of elements that can be stored in the buffer.
+         * @return Capacity of the buffer.
+         */
+        std::size_t capacity() const {
+            return data_.size();
+        }
+
+        /**
+         * @brief Returns the number of elements ready to be read.
+         * @return Number of elements in the buffer.
+         */
+        std::size_t available() const {
+            const auto read = read_index_.load(std::memory_order_acquire);
+            const auto write = write_index_.load(std::memory_order_acquire);
+            return std::min(write - read, capacity());
+        }
+
+        /**
+         * @brief Returns the number of elements that can be written without overflowing the buffer.
+         * @return Number of free elements in the buffer.
+         */
+        std::size_t space() const {
+            return capacity() - available();
+        }
+
+        /**
+         * @brief Checks if the buffer is empty.
+         * @return True if there is nothing to read, false otherwise.
+         */
+        bool empty() const {
+            return available() == 0;
+        }
+
+        /**
+         * @brief Writes all the elements in the buffer.
+         * @note Producer side only.
+         * @param data Array storing the elements.
+         * @param size Number of elements to write.
+         * @return False if there was not enough space to store all the elements, in that case nothing is written.
+         */
+        bool write(const T* data, std::size_t size) {
+            const auto write = write_index_.load(std::memory_order_relaxed);
+            const auto read = read_index_.load(std::memory_order_acquire);
+            if (capacity() - (write - read) < size) {
+                return false;
+            } else if (size == 0) {
+                return true;
+            }
+
+            const auto start = write % capacity();
+            const auto first = std::min(size, capacity() - start);
+            std::copy(data, data + first, data_.begin() + start);
+            std::copy(data + first, data + size, data_.begin());
+            write_index_.store(write + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Reads and removes the given number of elements from the buffer.
+         * @note Consumer side only.
+         * @param data Array where the elements are stored.
+         * @param size Number of elements to read.
+         * @return False if there were not enough elements available, in that case nothing is read.
+         */
+        bool read(T* data, std::size_t size) {
+            const auto read = read_index_.load(std::memory_order_relaxed);
+            const auto write = write_index_.load(std::memory_order_acquire);
+            if (write - read < size) {
+                return false;
+            } else if (size == 0) {
+                return true;
+            }
+
+            const auto start = read % capacity();
+            const auto first = std::min(size, capacity() - start);
+            std::copy(data_.begin() + start, data_.begin() + start + first, data);
+            std::copy(data_.begin(), data_.begin() + (size - first), data + first);
+            read_index_.store(read + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes the given number of elements from the buffer without reading them.
+         * @note Consumer side only.
+         * @param size Number of elements to discard.
+         * @return False if there were not enough elements available, in that case nothing is discarded.
+         */
+        bool discard(std::size_t size) {
+            const auto read = read_index_.load(std::memory_order_relaxed);
+            const auto write = write_index_.load(std::memory_order_acquire);
+            if (write - read < size) {
+                return false;
+            }
+            read_index_.store(read + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Makes the last consumed elements available again, as long as they have not been overwritten.
+         * @note Consumer side only. The producer side should not be in use, since the elements handed back to the
+         * consumer take space from the producer.
+         * @param size Number of elements to restore.
+         * @return False if some of the elements were already overwritten, in that case nothing is restored.
+         */
+        bool rewind(std::size_t size) {
+            const auto read = read_index_.load(std::memory_order_relaxed);
+            const auto write = write_index_.load(std::memory_order_acquire);
+            if (size > read || write - (read - size) > capacity()) {
+                return false;
+            }
+            read_index_.store(read - size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Removes all the elements in the buffer.
+         * @note This function is not thread-safe, none of the sides should be in use.
+         */
+        void reset() {
+            write_index_.store(0, std::memory_order_relaxed);
+            read_index_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        std::vector<T> data_;
+        alignas(64) std::atomic<std::size_t> write_index_{0};
+        alignas(64) std::atomic<std::size_t> read_index_{0};
+    };
+
+}
+
+#endif //SMARTCORE_RING_BUFFER_HPP
@@ -39,7 +39,7 @@ namespace score {
          * @param output Vector storing the output audio samples.
          * @throws std::invalid_argument if the length of the frame is invalid.
          */
-        void process(const AudioBuffer& input, AudioBuffer& output);
+        void process(const AudioBufferView& input, AudioBuffer& output);
 
     private:
         struct Pimpl;
@@ -0,0 +1,129 @@
+#ifndef SMARTCORE_SPEEX_PREPROCESSOR_HPP
+#define SMARTCORE_SPEEX_PREPROCESSOR_HPP
+
+#include <acoustic_echo_canceller.hpp>
+#include <audio_buffer.hpp>
+#include <thread_pool.hpp>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Fused Speex preprocessing block.
+     *
+     * Runs any combination of noise suppression, de-reverberation, residual echo suppression and voice activity
+     * detection on a single Speex preprocessor state per channel. The features share one analysis and synthesis of
+     * every frame, and one conversion to 16-bit samples, instead of running a state per feature.
+     */
+    class SpeexPreprocessor {
+    public:
+
+        /**
+         * @brief Features that can be combined in the preprocessor.
+         */
+        enum Feature {
+            Denoise = 1 << 0,           /*!< Noise suppression */
+            DeReverb = 1 << 1,          /*!< De-reverberation */
+            EchoSuppression = 1 << 2,   /*!< Residual echo suppression, requires an echo canceller */
+            VoiceDetection = 1 << 3     /*!< Voice activity detection, see isVoice() */
+        };
+
+        /**
+         * @brief Creates a preprocessor running the given features.
+         * @param sample_rate Sampling rate in Hz
+         * @param channels Number of channels
+         * @param frames_per_buffer Number of samples to process at one time (should correspond to 10-20 ms)
+         * @param features Bitwise combination of Feature values.
+         * @throws std::invalid_argument if the configuration is not valid.
+         */
+        SpeexPreprocessor(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_buffer,
+                          int features = Denoise);
+
+        /**
+         * @brief Default destructor
+         */
+        ~SpeexPreprocessor();
+
+        /**
+         * @brief Returns the features run by the preprocessor.
+         * @return Bitwise combination of Feature values.
+         */
+        int features() const;
+
+        /**
+         * @brief Links the residual echo suppression to the echo canceller, which estimates the residual echo of
+         * every channel.
+         * @param aec Echo canceller processing the same channels before this block. It must outlive the preprocessor.
+         * @throws std::invalid_argument if the canceller does not use the Speex MDF backend with one reference per
+         * channel, or if it has a different number of channels, sampling rate or frame size.
+         */
+        void setEchoCanceller(const AEC& aec);
+
+        /**
+         * @brief Sets the maximum attenuation of the noise in dB
+         * @param attenuation_db Negative number representing the attenuation in dB.
+         */
+        void setNoiseSuppression(int attenuation_db);
+
+        /**
+         * @brief Returns the maximum attenuation of the noise in dB
+         * @return Negative number representing the attenuation in dB.
+         */
+        int noiseSuppression() const;
+
+        /**
+         * @brief Sets the maximum attenuation of the residual echo in dB
+         * @param attenuation_db Negative number representing the attenuation in dB.
+         */
+        void setMaximumAttenuation(int attenuation_db);
+
+        /**
+         * @brief Returns the maximum attenuation of the residual echo in dB
+         * @return Negative number representing the attenuation in dB.
+         */
+        int maximumAttenuation() const;
+
+        /**
+         * @brief Sets the maximum attenuation of the residual echo in dB when the near end is active
+         * @param attenuation_db Negative number representing the attenuation in dB.
+         */
+        void setMaximumAttenuationNearEnd(int attenuation_db);
+
+        /**
+         * @brief Returns the maximum attenuation of the residual echo in dB when the near end is active
+         * @return Negative number representing the attenuation in dB.
+         */
+        int maximumAttenuationNearEnd() const;
+
+        /**
+         * @brief Returns whether the last processed frame of a channel contains voice.
+         * @param channel Index of the channel.
+         * @return True if voice was detected.
+         * @throws std::runtime_error if the voice activity detection is not enabled.
+         */
+        bool isVoice(std::size_t channel = 0) const;
+
+        /**
+         * @brief Runs the enabled features on a frame.
+         * @param input Input buffer
+         * @param output Output buffer
+         * @throws std::runtime_error if the echo suppression is enabled and no echo canceller is linked.
+         */
+        void process(const AudioBufferView& input, AudioBuffer& output);
+
+        /**
+         * @brief Sets the pool used to process the channels in parallel.
+         * @note Each channel runs its own preprocessor, so the output does not depend on the pool.
+         * @note Short frames are processed serially, see ThreadPool::MinimumParallelWork.
+         * @param pool Pool of threads, or nullptr to process the channels serially.
+         */
+        void setThreadPool(const std::shared_ptr<ThreadPool>& pool);
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_SPEEX_PREPROCESSOR_HPP
@@ -0,0 +1,100 @@
+#ifndef SMARTCORE_SRP_PHAT_HPP
+#define SMARTCORE_SRP_PHAT_HPP
+
+#include <array_geometry.hpp>
+#include <audio_buffer.hpp>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Steered Response Power with Phase Transform (SRP-PHAT) direction of arrival estimator.
+     *
+     * The PHAT-weighted cross correlation of every pair of microphones is computed once per frame. The steered
+     * response power of a direction is the sum, over all the pairs, of the correlation at the delay the direction
+     * induces between both microphones. Those delays are precomputed for a grid of far-field directions and stored
+     * as one contiguous row per pair, so the evaluation of the grid is a vectorizable gather-and-add.
+     *
+     * The search is done in two steps: the whole coarse grid is evaluated first, and then the fine grid is only
+     * evaluated in the neighbourhood of the best coarse direction.
+     */
+    class SrpPhat {
+    public:
+
+        /**
+         * @brief Direction of arrival in degrees.
+         */
+        struct Direction {
+            float azimuth;      /*!< Angle in the XY plane, measured from the X axis: [0, 360) */
+            float elevation;    /*!< Angle above the XY plane: [-90, 90] */
+            float power;        /*!< Steered response power, averaged over the pairs of microphones */
+        };
+
+        /**
+         * @brief Creates an estimator for the given array of microphones.
+         * @param sample_rate Sampling rate in Hz.
+         * @param frames_per_channel Number of samples per channel of the input frames.
+         * @param microphones Geometry of the array, with the microphones in the same order as the channels.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @throws std::invalid_argument if there are less than two microphones.
+         */
+        SrpPhat(std::int32_t sample_rate, std::size_t frames_per_channel,
+                const ArrayGeometry& microphones, float sound_speed = 343.2f);
+
+        /**
+         * @brief Default destructor
+         */
+        ~SrpPhat();
+
+        /**
+         * @brief Sets the angular resolution of the search grids and rebuilds the steering tables.
+         * @param coarse Step in degrees of the coarse grid.
+         * @param fine Step in degrees of the fine grid, the resolution of the estimated direction.
+         * @throws std::invalid_argument if the steps are not positive or the fine step is bigger than the coarse one.
+         */
+        void setResolution(float coarse, float fine);
+
+        /**
+         * @brief Sets the range of elevations searched and rebuilds the steering tables.
+         * By default, only the XY plane is searched (elevation of 0 degrees), as expected from a planar array.
+         * @param minimum Minimum elevation in degrees.
+         * @param maximum Maximum elevation in degrees.
+         * @throws std::invalid_argument if the range is not included in [-90, 90].
+         */
+        void setElevationRange(float minimum, float maximum);
+
+        /**
+         * @brief Returns the number of directions of the coarse grid.
+         * @return Number of directions.
+         */
+        std::size_t coarseDirections() const;
+
+        /**
+         * @brief Returns the number of directions of the fine grid.
+         * @return Number of directions.
+         */
+        std::size_t fineDirections() const;
+
+        /**
+         * @brief Returns the steered response power of every direction of the coarse grid in the last frame, summed
+         * over the pairs of microphones. The directions are sorted by elevation and then by azimuth.
+         * @return Steered response power of the coarse grid.
+         */
+        const Vector<float>& coarsePower() const;
+
+        /**
+         * @brief Estimates the direction of arrival of the dominant source in the frame.
+         * @param input Frame with one channel per microphone.
+         * @return Direction with the highest steered response power.
+         * @throws std::invalid_argument if the frame does not match the configured format.
+         */
+        Direction process(const AudioBufferView& input);
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_SRP_PHAT_HPP
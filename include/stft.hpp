@@ -0,0 +1,130 @@
+#ifndef SMARTCORE_STFT_HPP
+#define SMARTCORE_STFT_HPP
+
+#include <audio_buffer.hpp>
+#include <complex>
+#include <memory>
+
+namespace score {
+
+    /**
+     * @brief Short-Time Fourier Transform of multi-channel streams, with weighted overlap-add (WOLA) synthesis.
+     *
+     * Every call to analyze() consumes one hop of samples per channel and transforms the last frame of every
+     * channel. Every call to synthesize() transforms back a set of spectra, weights them with the synthesis window
+     * and overlap-adds them to the previous frames, producing one hop of samples per channel. The synthesis window
+     * is derived from the analysis one so that analysis followed by synthesis reconstructs the input delayed by
+     * latency() samples, for any hop where the windows overlap.
+     *
+     * The history of the analysis and the overlap of the synthesis persist between calls, and every buffer is
+     * allocated at construction, so frequency-domain blocks can run at any overlap without allocating memory.
+     */
+    class STFT {
+    public:
+
+        /**
+         * @brief Analysis windows.
+         */
+        enum Window {
+            Rectangular,
+            Hann,
+            SqrtHann,       /*!< Square root of the periodic Hann window, the usual choice at 50% overlap */
+            Hamming
+        };
+
+        /**
+         * @brief Creates a transform for the given configuration.
+         * @param channels Number of channels.
+         * @param frame_size Number of samples of every analysed frame.
+         * @param hop_size Number of samples between two consecutive frames, at most frame_size.
+         * @param fft_size Size of the transform, frames are zero-padded up to it. Zero to use frame_size.
+         * @param window Analysis window.
+         * @throws std::invalid_argument if the configuration is not valid.
+         */
+        STFT(std::int8_t channels, std::size_t frame_size, std::size_t hop_size, std::size_t fft_size = 0,
+             Window window = SqrtHann);
+
+        /**
+         * @brief Default destructor
+         */
+        ~STFT();
+
+        /**
+         * @brief Returns the number of channels.
+         * @return Number of channels.
+         */
+        std::int8_t channels() const;
+
+        /**
+         * @brief Returns the number of samples of every analysed frame.
+         * @return Frame size in samples.
+         */
+        std::size_t frameSize() const;
+
+        /**
+         * @brief Returns the number of samples consumed and produced in every call.
+         * @return Hop size in samples.
+         */
+        std::size_t hopSize() const;
+
+        /**
+         * @brief Returns the size of the transform.
+         * @return FFT size in samples.
+         */
+        std::size_t fftSize() const;
+
+        /**
+         * @brief Returns the number of non-redundant frequency bins of every spectrum.
+         * @return fftSize() / 2 + 1
+         */
+        std::size_t bins() const;
+
+        /**
+         * @brief Returns the delay between the analysed input and the synthesized output.
+         * @return frameSize() - hopSize() samples.
+         */
+        std::size_t latency() const;
+
+        /**
+         * @brief Consumes one hop of samples per channel and transforms the last frame of every channel.
+         * @param input Frame of hopSize() samples per channel.
+         * @return Spectra of the channels, one row per channel and one column per bin.
+         * @throws std::invalid_argument if the frame does not match the configured format.
+         */
+        const Matrix<std::complex<float>>& analyze(const AudioBufferView& input);
+
+        /**
+         * @brief Returns the spectra of the last analysed frame, which can be modified in place.
+         * @return Spectra of the channels, one row per channel and one column per bin.
+         */
+        Matrix<std::complex<float>>& spectra();
+
+        /**
+         * @brief Transforms back the spectra of the last analysed frame and produces one hop of every channel.
+         * @param output Buffer storing hopSize() samples per channel.
+         */
+        void synthesize(AudioBuffer& output);
+
+        /**
+         * @brief Transforms back a set of spectra and produces one hop of samples per spectrum.
+         * The first rows use the overlap of the first channels, so a block can synthesize fewer channels than it
+         * analyses, as a beamformer does.
+         * @param spectra One row per output channel, at most channels(), and one column per bin.
+         * @param output Buffer storing hopSize() samples per output channel.
+         * @throws std::invalid_argument if the spectra do not match the configured format.
+         */
+        void synthesize(const Matrix<std::complex<float>>& spectra, AudioBuffer& output);
+
+        /**
+         * @brief Re-initializes the block, clearing the history of the analysis and the overlap of the synthesis.
+         */
+        void reset();
+
+    private:
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_STFT_HPP
@@ -1,17 +1,24 @@
 #ifndef SMARTCORE_TDOA_HPP
 #define SMARTCORE_TDOA_HPP
 
+#include <array_geometry.hpp>
 #include <audio_buffer.hpp>
+#include <gcc_phat.hpp>
 #include <memory>
 
 namespace score {
 
+    /**
+     * @brief Estimates the time delay of arrival of every channel with respect to a reference one, using GCC-PHAT.
+     * @see GccPhat
+     */
     class TDOA {
     public:
         /**
          * Creates a TDOA estimator with the given configuration
          * @param sample_rate Sampling frequency in Hz.
          * @param channels Number of channels
+         * @param frames_per_buffer Number of samples per channel.
          * @param reference Reference microphone: [0, channels - 1].
          */
         TDOA(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_buffer, std::int8_t reference = 0);
@@ -27,12 +34,29 @@ namespace score {
          */
         void setMargin(std::int32_t margin);
 
+        /**
+         * @brief Derives the margin of every channel from the geometry of the array.
+         * The delays are only searched up to the distance between every microphone and the reference one, which
+         * discards spurious peaks and reduces the cost of the peak search.
+         * @param geometry Geometry of the array, with the microphones in the same order as the channels.
+         * @param sound_speed Speed of the sound in m/sec.
+         * @throws std::invalid_argument if the number of microphones does not match the number of channels.
+         */
+        void setGeometry(const ArrayGeometry& geometry, float sound_speed = 343.2f);
+
+        /**
+         * @brief Sets the method used to estimate delays between samples.
+         * By default, the delays are refined with a parabolic interpolation.
+         * @param interpolation Interpolation method.
+         */
+        void setInterpolation(GccPhat::Interpolation interpolation);
+
         /**
          * @brief Estimated the time delay (TOA) in each channel
          * @param input Audio frame containing the audio samples.
          * @return Array holding the estimated time-delay in seconds in each channel
          */
-        const Vector<float> process(const AudioBuffer& input);
+        const Vector<float> process(const AudioBufferView& input);
 
     private:
         struct Pimpl;
@@ -0,0 +1,81 @@
+#ifndef SMARTCORE_THREAD_POOL_HPP
+#define SMARTCORE_THREAD_POOL_HPP
+
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+namespace score {
+
+    /**
+     * @brief Persistent pool of worker threads used to run independent tasks in parallel.
+     *
+     * The workers are created once and sleep between jobs, so dispatching a job does not create threads nor
+     * allocate memory. The calling thread takes part in the job and only returns once every task is finished.
+     * Jobs submitted from several threads are executed one after the other, and jobs submitted from inside a task
+     * run serially in the calling thread.
+     */
+    class ThreadPool {
+    public:
+
+        /**
+         * @brief Creates a pool with the given number of threads, including the calling thread.
+         * @param threads Number of threads running each job.
+         */
+        explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+
+        /**
+         * @brief Default destructor
+         */
+        ~ThreadPool();
+
+        /**
+         * @brief Returns the number of threads running each job, including the calling thread.
+         * @return Number of threads.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Calls function(i) for every i in [0, count), spreading the calls among the threads of the pool.
+         * @note If any call throws, the first exception is re-thrown once all the tasks are finished.
+         * @param count Number of tasks.
+         * @param function Callable object taking the index of the task.
+         */
+        /**
+         * @brief Minimum estimated work of a job, in nanoseconds, for it to be dispatched to the pool.
+         *
+         * Waking the workers and waiting for the last task costs a few microseconds, so the blocks of the library
+         * only dispatch their channels when the frame takes an order of magnitude longer to process. Every block
+         * estimates the work of a frame as its number of samples times its approximate cost per sample, and
+         * processes shorter frames serially in the calling thread.
+         */
+        static constexpr std::size_t MinimumParallelWork = 50000;
+
+        /**
+         * @brief Returns whether a job of the given estimated work is worth dispatching to the pool.
+         * @param work Estimated work of the job in nanoseconds.
+         * @return True if the work reaches MinimumParallelWork.
+         */
+        static constexpr bool isWorthDispatching(std::size_t work) {
+            return work >= MinimumParallelWork;
+        }
+
+        template <typename Function>
+        void parallelFor(std::size_t count, Function&& function) {
+            using Callable = typename std::remove_reference<Function>::type;
+            dispatch(count, [](void* context, std::size_t index) {
+                (*static_cast<Callable*>(context))(index);
+            }, const_cast<void*>(static_cast<const void*>(&function)));
+        }
+
+    private:
+        using Task = void (*)(void* context, std::size_t index);
+        void dispatch(std::size_t count, Task task, void* context);
+
+        struct Pimpl;
+        std::unique_ptr<Pimpl> pimpl_;
+    };
+
+}
+
+#endif //SMARTCORE_THREAD_POOL_HPP
@@ -98,7 +98,7 @@ namespace score {
          * @throws std::invalid_argument if the length of the frame is invalid.
          * @return True in case of voice activity, false otherwise.
          */
-        bool process(const AudioBuffer& input);
+        bool process(const AudioBufferView& input);
 
     private:
         struct Pimpl;
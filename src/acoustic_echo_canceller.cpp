@@ -1,16 +1,37 @@
 #include "acoustic_echo_canceller.hpp"
+#include "acoustic_echo_canceller_internal.hpp"
 #include "utils.hpp"
 #include <speex/speex_echo.h>
+#include <modules/audio_processing/aec3/echo_canceller3.h>
+#include <modules/audio_processing/audio_buffer.h>
 
 using namespace score;
 
 struct AEC::Pimpl {
 
+    // Cost in nanoseconds per sample, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSample = 200ul;
+
     struct Handler {
 
-        Handler(std::int32_t sample_rate, std::size_t frame_size, std::size_t filter_length) {
-            state_ = speex_echo_state_init(static_cast<int>(frame_size),
-                                              static_cast<int>(filter_length));
+        virtual ~Handler() = default;
+
+        virtual void reset() = 0;
+
+        virtual void process(const float* recorded, const float* played, float* output) = 0;
+    };
+
+    // Works with interleaved frames. With several speakers, Speex transforms every far-end channel once per frame
+    // and shares its spectrum with the filters of all the microphones.
+    struct SpeexHandler : Handler {
+
+        SpeexHandler(std::int32_t sample_rate, std::size_t frame_size, std::size_t filter_length,
+                std::int8_t microphones = 1, std::int8_t speakers = 1) :
+            record_(frame_size * microphones),
+            play_(frame_size * speakers),
+            clean_(frame_size * microphones) {
+            state_ = speex_echo_state_init_mc(static_cast<int>(frame_size), static_cast<int>(filter_length),
+                                              microphones, speakers);
             if (state_ == nullptr) {
                 throw std::bad_alloc();
             }
@@ -18,20 +39,109 @@ struct AEC::Pimpl {
             speex_echo_ctl(state_, SPEEX_ECHO_SET_SAMPLING_RATE, &sample_rate);
         }
 
-        ~Handler() {
+        ~SpeexHandler() override {
             speex_echo_state_destroy(state_);
         }
 
+        void reset() override {
+            speex_echo_state_reset(state_);
+        }
+
+        void process(const float* recorded, const float* played, float* output) override {
+            Converter::FloatS16ToS16(recorded, record_.size(), record_.data());
+            Converter::FloatS16ToS16(played, play_.size(), play_.data());
+            speex_echo_cancellation(state_, record_.data(), play_.data(), clean_.data());
+            Converter::S16ToFloatS16(clean_.data(), clean_.size(), output);
+        }
+
         SpeexEchoState* state_;
+        std::vector<std::int16_t> record_;
+        std::vector<std::int16_t> play_;
+        std::vector<std::int16_t> clean_;
+    };
+
+    // AEC3 processes 10 ms frames, split in bands of 16 kHz above that rate, and keeps the samples in FloatS16.
+    struct WebRTCHandler : Handler {
+
+        WebRTCHandler(std::int32_t sample_rate, std::size_t frame_size, std::size_t filter_length) :
+            sample_rate_(sample_rate),
+            frame_size_(frame_size),
+            block_size_(static_cast<std::size_t>(sample_rate / 100)),
+            config_(makeConfig(sample_rate, filter_length)),
+            render_(block_size_, 1, block_size_, 1, block_size_),
+            capture_(block_size_, 1, block_size_, 1, block_size_) {
+            reset();
+        }
+
+        static webrtc::EchoCanceller3Config makeConfig(std::int32_t sample_rate, std::size_t filter_length) {
+            // The filters work with blocks of 64 samples of the lowest band.
+            const auto band_rate = webrtc::LowestBandRate(sample_rate);
+            const auto length = static_cast<double>(filter_length) * band_rate / sample_rate;
+            webrtc::EchoCanceller3Config config;
+            config.filter.main.length_blocks = static_cast<std::size_t>(std::ceil(length / webrtc::kBlockSize));
+            webrtc::EchoCanceller3Config::Validate(&config);
+            return config;
+        }
+
+        void reset() override {
+            canceller_ = std::make_unique<webrtc::EchoCanceller3>(config_, sample_rate_, true);
+        }
+
+        void process(const float* recorded, const float* played, float* output) override {
+            for (auto offset = 0ul; offset < frame_size_; offset += block_size_) {
+                split(played + offset, render_);
+                render(render_);
+                capture(recorded + offset, output + offset);
+            }
+        }
+
+        // Copies a block into the buffer and splits it into bands, so that it can be shared between cancellers.
+        static void split(const float* block, webrtc::AudioBuffer& buffer) {
+            std::copy(block, block + buffer.num_frames(), buffer.channels_f()[0]);
+            if (buffer.num_bands() > 1) {
+                buffer.SplitIntoFrequencyBands();
+            }
+        }
+
+        void render(webrtc::AudioBuffer& render) {
+            canceller_->AnalyzeRender(&render);
+        }
+
+        void capture(const float* recorded, float* output) {
+            const auto split = capture_.num_bands() > 1;
+            std::copy(recorded, recorded + block_size_, capture_.channels_f()[0]);
+            canceller_->AnalyzeCapture(&capture_);
+            if (split) {
+                capture_.SplitIntoFrequencyBands();
+            }
+            canceller_->ProcessCapture(&capture_, false);
+            if (split) {
+                capture_.MergeFrequencyBands();
+            }
+            std::copy(capture_.channels_const_f()[0], capture_.channels_const_f()[0] + block_size_, output);
+        }
+
+        std::int32_t sample_rate_;
+        std::size_t frame_size_;
+        std::size_t block_size_;
+        webrtc::EchoCanceller3Config config_;
+        webrtc::AudioBuffer render_;
+        webrtc::AudioBuffer capture_;
+        std::unique_ptr<webrtc::EchoCanceller3> canceller_{nullptr};
     };
 
-    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t filter_length) :
+    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::int8_t references, std::size_t frame_size,
+            std::size_t filter_length, Backend backend, bool shared) :
+        backend_(backend),
+        references_(references),
+        sample_rate_(sample_rate),
+        frame_size_(frame_size),
         channels_(channels),
-        record_(frame_size),
-        play_(frame_size),
-        clean_(frame_size),
-        states_(channels, Handler(sample_rate, frame_size, filter_length))
+        shared_(shared)
     {
+        if (channels <= 0 || references <= 0) {
+            throw std::invalid_argument("Expected a positive number of microphone and reference channels.");
+        }
 
         if (frame_size > 0.02 * sample_rate) {
             throw std::invalid_argument("Number of samples to process at one time "
@@ -43,7 +153,43 @@ struct AEC::Pimpl {
                                         "(should generally correspond to 100-500 ms)");
         }
 
+        if (backend_ == Backend::WebRTCAEC3) {
+            if (!webrtc::ValidFullBandRate(sample_rate)) {
+                throw std::invalid_argument("The AEC3 backend works at 8, 16, 32 or 48 kHz.");
+            }
+
+            if (frame_size == 0 || frame_size % (sample_rate / 100) != 0) {
+                throw std::invalid_argument("The AEC3 backend works with frames of a multiple of 10 ms.");
+            }
+
+            if (shared_ && references_ != 1) {
+                throw std::invalid_argument("The AEC3 backend shares a single reference channel.");
+            }
+        }
+
+        if (shared_ && backend_ == Backend::SpeexMDF) {
+            // A single state cancels the echo of every reference in every microphone.
+            states_.push_back(std::make_unique<SpeexHandler>(sample_rate, frame_size, filter_length,
+                                                             channels, references));
+            record_.resize(frame_size * channels);
+            play_.resize(frame_size * references);
+            clean_.resize(frame_size * channels);
+            return;
+        }
+
+        if (shared_) {
+            const auto block_size = static_cast<std::size_t>(sample_rate / 100);
+            render_ = std::make_unique<webrtc::AudioBuffer>(block_size, 1, block_size, 1, block_size);
+        }
 
+        states_.resize(channels);
+        for (auto& state : states_) {
+            if (backend_ == Backend::WebRTCAEC3) {
+                state = std::make_unique<WebRTCHandler>(sample_rate, frame_size, filter_length);
+            } else {
+                state = std::make_unique<SpeexHandler>(sample_rate, frame_size, filter_length);
+            }
+        }
     }
 
     ~Pimpl() {
@@ -51,59 +197,193 @@ struct AEC::Pimpl {
 
     void reset() {
         for (auto& state : states_)
-            speex_echo_state_reset(state.state_);
+            state->reset();
     }
-    
-    void process(const AudioBuffer& recorded, const AudioBuffer& played, AudioBuffer& output) {
-        int sample_rate = 0;
-        speex_echo_ctl(states_.front().state_, SPEEX_ECHO_GET_SAMPLING_RATE, &sample_rate);
 
-        if (recorded.sampleRate() != played.sampleRate() || recorded.sampleRate() != sample_rate) {
-            throw std::invalid_argument("Discrepancy in sampling rate. Expected " + std::to_string(sample_rate) + " Hz");
+    webrtc::EchoControl::Metrics metrics(std::size_t channel) const {
+        if (backend_ != Backend::WebRTCAEC3) {
+            throw std::runtime_error("The Speex MDF backend does not estimate the delay nor the ERLE.");
+        }
+
+        if (channel >= states_.size()) {
+            throw std::invalid_argument("Expected a channel in the range [0, " + std::to_string(channels_) + ").");
         }
-        
+        return static_cast<const WebRTCHandler&>(*states_[channel]).canceller_->GetMetrics();
+    }
+
+    std::vector<SpeexEchoState*> speexStates() const {
+        if (backend_ != Backend::SpeexMDF || shared_) {
+            throw std::invalid_argument("Expected an AEC with the Speex MDF backend and a reference per channel.");
+        }
+
+        std::vector<SpeexEchoState*> states(states_.size());
+        for (auto i = 0ul; i < states_.size(); ++i) {
+            states[i] = static_cast<const SpeexHandler&>(*states_[i]).state_;
+        }
+        return states;
+    }
+
+    void process(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& output) {
+        if (!recorded.isContiguous() || !played.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
+        if (recorded.sampleRate() != played.sampleRate() || recorded.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected " + std::to_string(sample_rate_) + " Hz");
+        }
+
         if (channels_ != recorded.channels()) {
-            throw std::invalid_argument("The AEC is configure to work with " 
+            throw std::invalid_argument("The AEC is configure to work with "
                                         + std::to_string(channels_) + " record channels.");
         }
 
-        if (channels_ != played.channels()) {
+        if (references_ != played.channels()) {
             throw std::invalid_argument("The AEC is configure to work with "
-                                        + std::to_string(channels_) + " play channels.");
+                                        + std::to_string(references_) + " play channels.");
         }
 
-        int frame_size = 0;
-        speex_echo_ctl(states_.front().state_, SPEEX_ECHO_GET_FRAME_SIZE, &frame_size);
-        if (recorded.framesPerChannel() != frame_size || played.framesPerChannel() != frame_size) {
-            throw std::invalid_argument("The AEC is configure to work with " + std::to_string(frame_size)
+        if (recorded.framesPerChannel() != frame_size_ || played.framesPerChannel() != frame_size_) {
+            throw std::invalid_argument("The AEC is configure to work with " + std::to_string(frame_size_)
             + " frames per buffer.");
         }
 
-        output.setSampleRate(sample_rate);
-        output.resize(channels_, frame_size);
-        for (auto i = 0ul; i < channels_; ++i) {
-            Converter::FloatS16ToS16(recorded.channel(i), recorded.framesPerChannel(), record_.data());
-            Converter::FloatS16ToS16(played.channel(i), played.framesPerChannel(), play_.data());
-            speex_echo_cancellation(states_[i].state_, record_.data(), play_.data(), clean_.data());
-            Converter::S16ToFloatS16(clean_.data(), clean_.size(), output.channel(i));
+        output.setSampleRate(sample_rate_);
+        output.resize(channels_, frame_size_);
+        if (shared_ && backend_ == Backend::SpeexMDF) {
+            processShared(recorded, played, output);
+            return;
+        }
+
+        if (shared_) {
+            processSharedBlocks(recorded, played, output);
+            return;
+        }
+
+        const auto process_channel = [&](std::size_t i) {
+            states_[i]->process(recorded.channel(i), played.channel(i), output.channel(i));
+        };
+
+        if (pool_ && ThreadPool::isWorthDispatching(recorded.size() * CostPerSample)) {
+            pool_->parallelFor(channels_, process_channel);
+        } else {
+            for (auto i = 0ul; i < channels_; ++i) {
+                process_channel(i);
+            }
+        }
+    }
+
+    void processShared(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& output) {
+        for (auto n = 0ul, index = 0ul; n < frame_size_; ++n) {
+            for (auto i = 0ul; i < channels_; ++i, ++index) {
+                record_[index] = recorded(i, n);
+            }
         }
+
+        for (auto n = 0ul, index = 0ul; n < frame_size_; ++n) {
+            for (auto i = 0ul; i < references_; ++i, ++index) {
+                play_[index] = played(i, n);
+            }
+        }
+
+        states_.front()->process(record_.data(), play_.data(), clean_.data());
+        output.fromInterleave(channels_, frame_size_, clean_.data());
     }
 
+    void processSharedBlocks(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& output) {
+        // The reference is split into bands once per block and queued in every canceller before the captures,
+        // which only read their own state and run in parallel. Every canceller still analyses the queued
+        // reference on its own, as EchoCanceller3 does not expose its render pipeline.
+        const auto block_size = render_->num_frames();
+        for (auto offset = 0ul; offset < frame_size_; offset += block_size) {
+            WebRTCHandler::split(played.channel(0) + offset, *render_);
+            for (auto& state : states_) {
+                static_cast<WebRTCHandler&>(*state).render(*render_);
+            }
+
+            const auto process_channel = [&](std::size_t i) {
+                static_cast<WebRTCHandler&>(*states_[i]).capture(recorded.channel(i) + offset,
+                                                                 output.channel(i) + offset);
+            };
+
+            if (pool_ && ThreadPool::isWorthDispatching(recorded.size() * CostPerSample)) {
+                pool_->parallelFor(channels_, process_channel);
+            } else {
+                for (auto i = 0ul; i < channels_; ++i) {
+                    process_channel(i);
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+    Backend backend_;
+    std::int8_t references_;
+    std::int32_t sample_rate_;
+    std::size_t frame_size_;
+
 private:
-    std::vector<Handler>  states_{};
-    std::vector<std::int16_t> record_;
-    std::vector<std::int16_t> play_;
-    std::vector<std::int16_t> clean_;
     std::int8_t channels_;
+    bool shared_;
+    std::vector<std::unique_ptr<Handler>> states_{};
+    std::unique_ptr<webrtc::AudioBuffer> render_{nullptr};
+    std::vector<float> record_{};
+    std::vector<float> play_{};
+    std::vector<float> clean_{};
 };
 
-score::AEC::AEC(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t filter_length) :
-    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, frame_size, filter_length)) {
+score::AEC::AEC(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t filter_length,
+        Backend backend) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, channels, frame_size, filter_length, backend, false)) {
+
+}
+
+score::AEC::AEC(std::unique_ptr<Pimpl> pimpl) : pimpl_(std::move(pimpl)) {
+
+}
 
+AEC score::AEC::MultiReference(std::int32_t sample_rate, std::int8_t channels, std::int8_t references,
+        std::size_t frame_size, std::size_t filter_length, Backend backend) {
+    return AEC(std::make_unique<Pimpl>(sample_rate, channels, references, frame_size, filter_length, backend, true));
 }
 
-void score::AEC::process(const AudioBuffer &recorded, const AudioBuffer &played, AudioBuffer &output) {
+void score::AEC::process(const AudioBufferView &recorded, const AudioBufferView &played, AudioBuffer &output) {
     pimpl_->process(recorded, played, output);
 }
 
+void score::AEC::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
+AEC::Backend score::AEC::backend() const {
+    return pimpl_->backend_;
+}
+
+std::int8_t score::AEC::references() const {
+    return pimpl_->references_;
+}
+
+std::int32_t score::AEC::delay(std::size_t channel) const {
+    return pimpl_->metrics(channel).delay_ms;
+}
+
+float score::AEC::erle(std::size_t channel) const {
+    return static_cast<float>(pimpl_->metrics(channel).echo_return_loss_enhancement);
+}
+
+std::vector<SpeexEchoState*> score::AECInternals::speexStates(const AEC &aec) {
+    return aec.pimpl_->speexStates();
+}
+
+std::int32_t score::AECInternals::sampleRate(const AEC &aec) {
+    return aec.pimpl_->sample_rate_;
+}
+
+std::size_t score::AECInternals::frameSize(const AEC &aec) {
+    return aec.pimpl_->frame_size_;
+}
+
+score::AEC::AEC(AEC &&other) noexcept = default;
+
+AEC &score::AEC::operator=(AEC &&other) noexcept = default;
+
 score::AEC::~AEC() = default;
@@ -0,0 +1,41 @@
+#ifndef SMARTCORE_ECHO_CANCELLER_INTERNAL_HPP
+#define SMARTCORE_ECHO_CANCELLER_INTERNAL_HPP
+
+#include <acoustic_echo_canceller.hpp>
+#include <speex/speex_echo.h>
+#include <vector>
+
+namespace score {
+
+    /**
+     * @brief Access to the internal state of an AEC for the blocks of the library built on top of it.
+     * It is not installed with the public headers, so the Speex types stay out of the interface of the AEC.
+     */
+    struct AECInternals {
+
+        /**
+         * @brief Returns the Speex state of every channel, used to estimate the residual echo.
+         * @param aec Echo canceller.
+         * @return One state per channel, owned by the canceller.
+         * @throws std::invalid_argument if the canceller does not run one Speex MDF state per channel.
+         */
+        static std::vector<SpeexEchoState*> speexStates(const AEC& aec);
+
+        /**
+         * @brief Returns the sampling rate the canceller is configured with.
+         * @param aec Echo canceller.
+         * @return Sampling rate in Hz.
+         */
+        static std::int32_t sampleRate(const AEC& aec);
+
+        /**
+         * @brief Returns the number of samples per channel the canceller processes at one time.
+         * @param aec Echo canceller.
+         * @return Frame size in samples.
+         */
+        static std::size_t frameSize(const AEC& aec);
+    };
+
+}
+
+#endif //SMARTCORE_ECHO_CANCELLER_INTERNAL_HPP
@@ -0,0 +1,113 @@
+#include "array_geometry.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    constexpr auto Radians = M_PI / 180.0;
+
+}
+
+score::ArrayGeometry::ArrayGeometry(const std::vector<Point<float>> &microphones) :
+    microphones_(microphones) {
+    if (microphones_.empty()) {
+        throw std::invalid_argument("Expected at least one microphone.");
+    }
+}
+
+ArrayGeometry score::ArrayGeometry::Linear(std::size_t microphones, double spacing) {
+    std::vector<Point<float>> positions;
+    const auto center = 0.5 * (static_cast<double>(microphones) - 1);
+    for (auto i = 0ul; i < microphones; ++i) {
+        positions.push_back({(static_cast<double>(i) - center) * spacing, 0, 0});
+    }
+    return ArrayGeometry(positions);
+}
+
+ArrayGeometry score::ArrayGeometry::Circular(std::size_t microphones, double radius, double offset) {
+    std::vector<Point<float>> positions;
+    for (auto i = 0ul; i < microphones; ++i) {
+        const auto angle = offset * Radians + 2 * M_PI * static_cast<double>(i) / microphones;
+        positions.push_back({radius * std::cos(angle), radius * std::sin(angle), 0});
+    }
+    return ArrayGeometry(positions);
+}
+
+ArrayGeometry score::ArrayGeometry::ReSpeaker4Mic() {
+    return Circular(4, 0.08127 / 2);
+}
+
+ArrayGeometry score::ArrayGeometry::ReSpeaker6Mic() {
+    return Circular(6, 0.09218 / 2);
+}
+
+std::size_t score::ArrayGeometry::size() const {
+    return microphones_.size();
+}
+
+const std::vector<Point<float>> &score::ArrayGeometry::microphones() const {
+    return microphones_;
+}
+
+const Point<float> &score::ArrayGeometry::operator[](std::size_t index) const {
+    return microphones_[index];
+}
+
+double score::ArrayGeometry::distance(std::size_t first, std::size_t second) const {
+    const auto& a = microphones_.at(first);
+    const auto& b = microphones_.at(second);
+    return std::sqrt((a[0] - b[0]) * (a[0] - b[0]) + (a[1] - b[1]) * (a[1] - b[1]) + (a[2] - b[2]) * (a[2] - b[2]));
+}
+
+double score::ArrayGeometry::aperture() const {
+    auto maximum = 0.0;
+    for (auto i = 0ul; i < microphones_.size(); ++i) {
+        for (auto j = i + 1; j < microphones_.size(); ++j) {
+            maximum = std::max(maximum, distance(i, j));
+        }
+    }
+    return maximum;
+}
+
+std::int32_t score::ArrayGeometry::maximumDelay(std::size_t first, std::size_t second, std::int32_t sample_rate,
+        float sound_speed) const {
+    return static_cast<std::int32_t>(std::ceil(distance(first, second) * sample_rate / sound_speed));
+}
+
+Matrix<float> score::ArrayGeometry::arrivalDelays(const std::vector<float> &azimuths,
+        const std::vector<float> &elevations, float sound_speed) const {
+    Matrix<float> delays(static_cast<Eigen::Index>(azimuths.size() * elevations.size()),
+                         static_cast<Eigen::Index>(microphones_.size()));
+    Eigen::Index row = 0;
+    for (const auto elevation : elevations) {
+        for (const auto azimuth : azimuths) {
+            const auto el = elevation * Radians;
+            const auto az = azimuth * Radians;
+            const Point<float> direction = {std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el)};
+            for (auto m = 0ul; m < microphones_.size(); ++m) {
+                const auto& position = microphones_[m];
+                const auto projection = position[0] * direction[0] + position[1] * direction[1]
+                                        + position[2] * direction[2];
+                delays(row, static_cast<Eigen::Index>(m)) = static_cast<float>(-projection / sound_speed);
+            }
+            ++row;
+        }
+    }
+    return delays;
+}
+
+std::vector<float> score::ArrayGeometry::AzimuthGrid(float step) {
+    if (step <= 0) {
+        throw std::invalid_argument("Expected a positive step.");
+    }
+
+    const auto size = static_cast<std::size_t>(std::ceil(360.0f / step - 1e-3f));
+    std::vector<float> azimuths(size);
+    for (auto i = 0ul; i < size; ++i) {
+        azimuths[i] = 360.0f * static_cast<float>(i) / static_cast<float>(size);
+    }
+    return azimuths;
+}
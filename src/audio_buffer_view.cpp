@@ -0,0 +1,193 @@
+#include "audio_buffer_view.hpp"
+#include "audio_buffer.hpp"
+
+#include <stdexcept>
+#include <string>
+
+using namespace score;
+
+constexpr std::size_t AudioBufferView::MaximumChannels;
+
+AudioBufferView::AudioBufferView() = default;
+
+AudioBufferView::AudioBufferView(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+        float* const* data, std::size_t stride) :
+    sample_rate_(sample_rate),
+    channels_(channels),
+    frames_per_channel_(frames_per_channel),
+    stride_(stride) {
+    if (channels < 0 || static_cast<std::size_t>(channels) > MaximumChannels) {
+        throw std::invalid_argument("Expected a number of channels in the range [0, "
+                                    + std::to_string(MaximumChannels) + "]. Received: "
+                                    + std::to_string(channels));
+    }
+    std::copy(data, data + channels, std::begin(data_));
+}
+
+AudioBufferView::AudioBufferView(AudioBuffer& buffer) :
+    AudioBufferView(static_cast<const AudioBuffer&>(buffer)) {
+
+}
+
+AudioBufferView::AudioBufferView(const AudioBuffer& buffer) :
+    type_(buffer.type()),
+    timestamp_(buffer.timestamp()),
+    sample_rate_(buffer.sampleRate()),
+    channels_(buffer.channels()),
+    frames_per_channel_(buffer.framesPerChannel()) {
+    if (static_cast<std::size_t>(channels_) > MaximumChannels) {
+        throw std::invalid_argument("Expected a number of channels in the range [0, "
+                                    + std::to_string(MaximumChannels) + "]. Received: "
+                                    + std::to_string(channels_));
+    }
+    for (auto i = 0ul; i < static_cast<std::size_t>(channels_); ++i) {
+        data_[i] = const_cast<float*>(buffer.channel(i));
+    }
+}
+
+AudioBufferView AudioBufferView::FromInterleave(std::int32_t sample_rate, std::int8_t channels,
+        std::size_t frames_per_channel, float* raw) {
+    Array<float*, MaximumChannels> pointers{};
+    for (auto i = 0ul; i < std::min<std::size_t>(channels, MaximumChannels); ++i) {
+        pointers[i] = raw + i;
+    }
+    return AudioBufferView(sample_rate, channels, frames_per_channel, pointers.data(),
+            static_cast<std::size_t>(channels));
+}
+
+std::int32_t AudioBufferView::sampleRate() const {
+    return sample_rate_;
+}
+
+std::int8_t AudioBufferView::channels() const {
+    return channels_;
+}
+
+std::size_t AudioBufferView::framesPerChannel() const {
+    return frames_per_channel_;
+}
+
+std::size_t AudioBufferView::stride() const {
+    return stride_;
+}
+
+bool AudioBufferView::isContiguous() const {
+    return stride_ == 1 || frames_per_channel_ <= 1;
+}
+
+bool AudioBufferView::isInterleaved() const {
+    if (stride_ != static_cast<std::size_t>(channels_)) {
+        return false;
+    }
+    for (auto i = 1ul; i < static_cast<std::size_t>(channels_); ++i) {
+        if (data_[i] != data_[0] + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t AudioBufferView::size() const {
+    return frames_per_channel_ * channels_;
+}
+
+std::size_t AudioBufferView::duration() const {
+    return static_cast<std::size_t >(1e3 * frames_per_channel_ / sample_rate_);
+}
+
+double AudioBufferView::timestamp() const {
+    return timestamp_;
+}
+
+void AudioBufferView::setTimestamp(double timestamp) {
+    timestamp_ = timestamp;
+}
+
+FrameType AudioBufferView::type() const {
+    return type_;
+}
+
+void AudioBufferView::setType(FrameType type) {
+    type_ = type;
+}
+
+float *AudioBufferView::channel(std::size_t channel) {
+    return data_[channel];
+}
+
+const float *AudioBufferView::channel(std::size_t channel) const {
+    return data_[channel];
+}
+
+float *AudioBufferView::operator[](std::size_t channel) {
+    return data_[channel];
+}
+
+const float *AudioBufferView::operator[](std::size_t channel) const {
+    return data_[channel];
+}
+
+float &AudioBufferView::operator()(std::size_t channel, std::size_t index) {
+    return data_[channel][index * stride_];
+}
+
+float AudioBufferView::operator()(std::size_t channel, std::size_t index) const {
+    return data_[channel][index * stride_];
+}
+
+AudioBufferView AudioBufferView::select(const std::vector<std::size_t>& indexes) const {
+    Array<float*, MaximumChannels> pointers{};
+    if (indexes.size() > MaximumChannels) {
+        throw std::invalid_argument("Expected a number of channels in the range [0, "
+                                    + std::to_string(MaximumChannels) + "]. Received: "
+                                    + std::to_string(indexes.size()));
+    }
+    for (auto i = 0ul; i < indexes.size(); ++i) {
+        if (indexes[i] >= static_cast<std::size_t>(channels_)) {
+            throw std::invalid_argument("Expected a channel index lower than " + std::to_string(channels_)
+                                        + ". Received: " + std::to_string(indexes[i]));
+        }
+        pointers[i] = data_[indexes[i]];
+    }
+
+    AudioBufferView view(sample_rate_, static_cast<std::int8_t>(indexes.size()), frames_per_channel_,
+            pointers.data(), stride_);
+    view.setTimestamp(timestamp_);
+    view.setType(type_);
+    return view;
+}
+
+void AudioBufferView::copyTo(AudioBuffer& buffer) const {
+    buffer.setSampleRate(sample_rate_);
+    if (buffer.channels() != channels_ || buffer.framesPerChannel() != frames_per_channel_) {
+        buffer.resize(channels_, frames_per_channel_);
+    }
+
+    for (auto i = 0ul; i < static_cast<std::size_t>(channels_); ++i) {
+        auto* output = buffer.channel(i);
+        if (output == data_[i]) {
+            continue;
+        } else if (stride_ == 1) {
+            std::copy(data_[i], data_[i] + frames_per_channel_, output);
+        } else {
+            for (auto j = 0ul; j < frames_per_channel_; ++j) {
+                output[j] = data_[i][j * stride_];
+            }
+        }
+    }
+    buffer.setTimestamp(timestamp_);
+    buffer.setType(type_);
+}
+
+void AudioBufferView::toInterleave(float* data) const {
+    if (isInterleaved()) {
+        std::copy(data_[0], data_[0] + size(), data);
+        return;
+    }
+
+    for (auto i = 0ul, index = 0ul; i < frames_per_channel_; ++i) {
+        for (auto j = 0ul; j < static_cast<std::size_t>(channels_); ++j, ++index) {
+            data[index] = data_[j][i * stride_];
+        }
+    }
+}
@@ -198,7 +198,7 @@ struct AGC::Pimpl {
         was_analog_level_set_ = false;
     }
 
-    void analyze(const AudioBuffer& input) {
+    void analyze(const AudioBufferView& input) {
         /*switch (mode_) {
             case Mode::AdaptiveAnalog:
                 for (auto i = 0ul; i < channels_; ++i) {
@@ -229,7 +229,11 @@ struct AGC::Pimpl {
         }*/
     }
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != channels_) {
             throw std::invalid_argument("Expected an input frame with "
                                         + std::to_string(channels_) + " channels.");
@@ -359,7 +363,7 @@ void score::AGC::setAnalogLevel(int level) {
     pimpl_->setAnalogLevel(level);
 }
 
-void score::AGC::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::AGC::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
@@ -0,0 +1,219 @@
+#include "batch_localizer.hpp"
+#include "audio_buffer.hpp"
+#include "decoder.hpp"
+#include "doa.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace score;
+
+struct BatchLocalizer::Pimpl {
+
+    Pimpl(std::int32_t sample_rate, const ArrayGeometry& geometry, std::size_t frames_per_channel,
+          float sound_speed) :
+        sample_rate_(sample_rate),
+        frames_per_channel_(frames_per_channel),
+        sound_speed_(sound_speed),
+        geometry_(geometry),
+        groups_(DOA::AllPairs(static_cast<std::uint8_t>(geometry.size()))) {
+
+        if (frames_per_channel_ == 0) {
+            throw std::invalid_argument("Expected at least one sample per frame.");
+        }
+        makeWorkers();
+    }
+
+    // Every thread of the pool owns a DOA block, so the tasks do not share any state.
+    void makeWorkers() {
+        const auto workers = pool_ ? pool_->size() : 1ul;
+        workers_.clear();
+        for (auto i = 0ul; i < workers; ++i) {
+            workers_.push_back(std::make_unique<DOA>(sample_rate_, geometry_, sound_speed_));
+            workers_.back()->setGroupMicrophones(groups_);
+        }
+    }
+
+    void localize(DOA& doa, const AudioBufferView& recording, std::size_t frame, std::size_t index) {
+        std::array<float*, AudioBufferView::MaximumChannels> channels{};
+        const auto offset = frame * frames_per_channel_ * recording.stride();
+        for (auto i = 0; i < recording.channels(); ++i) {
+            channels[i] = const_cast<float*>(recording.channel(static_cast<std::size_t>(i))) + offset;
+        }
+
+        const AudioBufferView view(sample_rate_, recording.channels(), frames_per_channel_, channels.data(),
+                                   recording.stride());
+        results_.azimuth[index] = doa.process(view);
+        results_.confidence[index] = doa.confidence();
+        results_.time[index] = recording.timestamp()
+                               + static_cast<double>(frame * frames_per_channel_) / sample_rate_;
+        const auto& delays = doa.delays();
+        std::copy(delays.begin(), delays.end(), results_.delays.row(static_cast<Eigen::Index>(index)).data());
+    }
+
+    const Results& process(const AudioBufferView& recording) {
+        append(recording);
+        trim();
+        return results_;
+    }
+
+    const Results& process(Decoder& decoder) {
+        if (static_cast<std::int32_t>(decoder.sampleRate()) != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected "
+                                        + std::to_string(sample_rate_) + " Hz");
+        }
+
+        // Every block keeps all the threads busy with a few chunks.
+        const auto block = frames_per_channel_ * chunk_ * workers_.size() * 4;
+        const auto length = decoder.framesPerChannel();
+        if (decoder.current() < length) {
+            reserve(frames_ + (length - decoder.current()) / frames_per_channel_);
+        }
+        try {
+            while (decoder.current() + frames_per_channel_ <= length) {
+                const auto position = decoder.current();
+                const auto remaining = length - position;
+                const auto frames = std::min(block, remaining - remaining % frames_per_channel_);
+                decoder.process(buffer_, frames);
+                buffer_.setTimestamp(static_cast<double>(position) / sample_rate_);
+                append(AudioBufferView(buffer_));
+            }
+        } catch (...) {
+            trim();
+            throw;
+        }
+        trim();
+        return results_;
+    }
+
+    // Localizes every complete frame of the recording after the frames already stored, without trimming the results.
+    void append(const AudioBufferView& recording) {
+        if (recording.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected "
+                                        + std::to_string(sample_rate_) + " Hz");
+        }
+
+        if (static_cast<std::size_t>(recording.channels()) != geometry_.size()) {
+            throw std::invalid_argument("The BatchLocalizer is configured to work with "
+                                        + std::to_string(geometry_.size()) + " channels.");
+        }
+
+        const auto frames = recording.framesPerChannel() / frames_per_channel_;
+        const auto first = frames_;
+        reserve(first + frames);
+
+        // Chunks are assigned round-robin, task t processing the chunks t, t + tasks, t + 2 * tasks...
+        const auto chunks = (frames + chunk_ - 1) / chunk_;
+        const auto tasks = std::min(chunks, workers_.size());
+        const auto process_task = [&](std::size_t task) {
+            auto& doa = *workers_[task];
+            for (auto chunk = task; chunk < chunks; chunk += tasks) {
+                for (auto frame = chunk * chunk_, end = std::min(frames, frame + chunk_); frame < end; ++frame) {
+                    localize(doa, recording, frame, first + frame);
+                }
+            }
+        };
+
+        if (pool_ && tasks > 1) {
+            pool_->parallelFor(tasks, process_task);
+        } else {
+            for (auto i = 0ul; i < tasks; ++i) {
+                process_task(i);
+            }
+        }
+        frames_ = first + frames;
+    }
+
+    // The storage grows geometrically, so appending many short blocks does not copy the results every time.
+    void reserve(std::size_t frames) {
+        const auto capacity = results_.frames();
+        if (frames <= capacity) {
+            return;
+        }
+
+        const auto size = std::max(frames, 2 * capacity);
+        results_.time.resize(size);
+        results_.azimuth.resize(size);
+        results_.confidence.resize(size);
+        results_.delays.conservativeResize(static_cast<Eigen::Index>(size), static_cast<Eigen::Index>(groups_.size()));
+    }
+
+    // Drops the rows reserved but not used yet.
+    void trim() {
+        if (results_.frames() == frames_) {
+            return;
+        }
+
+        results_.time.resize(frames_);
+        results_.azimuth.resize(frames_);
+        results_.confidence.resize(frames_);
+        results_.delays.conservativeResize(static_cast<Eigen::Index>(frames_),
+                                           static_cast<Eigen::Index>(groups_.size()));
+    }
+
+    void reset() {
+        results_ = Results();
+        frames_ = 0;
+    }
+
+    std::int32_t sample_rate_;
+    std::size_t frames_per_channel_;
+    float sound_speed_;
+    ArrayGeometry geometry_;
+    std::vector<std::pair<std::size_t, std::size_t>> groups_;
+    std::size_t chunk_{64};
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+    std::vector<std::unique_ptr<DOA>> workers_{};
+    AudioBuffer buffer_{};
+    Results results_{};
+    std::size_t frames_{0};
+};
+
+score::BatchLocalizer::BatchLocalizer(std::int32_t sample_rate, const ArrayGeometry &geometry,
+        std::size_t frames_per_channel, float sound_speed) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, geometry, frames_per_channel, sound_speed)) {
+
+}
+
+score::BatchLocalizer::~BatchLocalizer() = default;
+
+void score::BatchLocalizer::setGroupMicrophones(
+        const std::vector<std::pair<std::size_t, std::size_t>> &microphone_groups) {
+    if (pimpl_->frames_ != 0) {
+        throw std::runtime_error("The group of microphones can not change once the results hold any frame.");
+    }
+
+    for (auto& worker : pimpl_->workers_) {
+        worker->setGroupMicrophones(microphone_groups);
+    }
+    pimpl_->groups_ = microphone_groups;
+}
+
+void score::BatchLocalizer::setChunkSize(std::size_t frames) {
+    if (frames == 0) {
+        throw std::invalid_argument("Expected at least one frame per chunk.");
+    }
+    pimpl_->chunk_ = frames;
+}
+
+void score::BatchLocalizer::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+    pimpl_->makeWorkers();
+}
+
+const BatchLocalizer::Results &score::BatchLocalizer::process(const AudioBufferView &recording) {
+    return pimpl_->process(recording);
+}
+
+const BatchLocalizer::Results &score::BatchLocalizer::process(Decoder &decoder) {
+    return pimpl_->process(decoder);
+}
+
+const BatchLocalizer::Results &score::BatchLocalizer::results() const {
+    return pimpl_->results_;
+}
+
+void score::BatchLocalizer::reset() {
+    pimpl_->reset();
+}
@@ -3,12 +3,16 @@
 
 #include "beamformer.hpp"
 #include "downmix.hpp"
-#include "tdoa.h"
-#include "mvdr.h"
-#include "gsc.h"
+#include "gcc_phat.hpp"
+#include "stft.hpp"
 #include "ds.h"
 #include "utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+
 using namespace score;
 
 uint32_t nextPowerOfTwo(uint32_t n)
@@ -24,6 +28,433 @@ uint32_t nextPowerOfTwo(uint32_t n)
     return n + 1;
 }
 
+namespace {
+
+    /**
+     * Frequency-domain MVDR beamformer, w = R^-1 a / (a^H R^-1 a), processed with a 50% overlap STFT.
+     *
+     * The inverse of the noise covariance matrix of every bin is updated directly with the Sherman-Morrison formula,
+     * R^-1 being kept for all bins in a single contiguous block, and only in noise frames. The weights are only
+     * re-computed when the inverse or the steering delays change, so speech frames just apply them.
+     */
+    class MvdrFilter {
+    public:
+        using Complex = std::complex<float>;
+
+        MvdrFilter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+                   std::size_t fft_size) :
+            sample_rate_(sample_rate),
+            channels_(static_cast<std::size_t>(channels)),
+            stft_(channels, 2 * frames_per_channel, frames_per_channel, std::max(fft_size, 2 * frames_per_channel)),
+            bins_(stft_.bins()),
+            inverses_(bins_ * channels_ * channels_),
+            delays_(channels_, 0.0f),
+            steering_(channels_),
+            rotation_(channels_),
+            gain_(channels_),
+            snapshot_(channels_) {
+
+            output_.resize(1, static_cast<Eigen::Index>(bins_));
+            weights_.resize(static_cast<Eigen::Index>(bins_), static_cast<Eigen::Index>(channels_));
+            reset();
+        }
+
+        void setForgettingFactor(float factor) {
+            factor_ = factor;
+        }
+
+        void reset() {
+            // The covariance starts as white noise of unit trace, where MVDR is the delay-and-sum beamformer.
+            std::fill(inverses_.begin(), inverses_.end(), Complex(0.0f, 0.0f));
+            for (auto b = 0ul; b < bins_; ++b) {
+                for (auto m = 0ul; m < channels_; ++m) {
+                    inverse(b)[m * channels_ + m] = static_cast<float>(channels_);
+                }
+            }
+            stft_.reset();
+            loaded_ = 0;
+            stale_ = true;
+        }
+
+        void process(const AudioBufferView& input, bool noise, const float* delays, AudioBuffer& output) {
+            const auto& spectra = stft_.analyze(input);
+            for (auto m = 0ul; m < channels_; ++m) {
+                if (delays[m] != delays_[m]) {
+                    delays_[m] = delays[m];
+                    stale_ = true;
+                }
+            }
+
+            if (noise) {
+                update(spectra);
+            }
+
+            if (stale_) {
+                computeWeights();
+            }
+
+            // y = w^H x
+            auto* out = output_.data();
+            std::fill(out, out + bins_, Complex(0.0f, 0.0f));
+            for (auto m = 0ul; m < channels_; ++m) {
+                const auto* spectrum = spectra.row(static_cast<Eigen::Index>(m)).data();
+                for (auto b = 0ul; b < bins_; ++b) {
+                    out[b] += std::conj(weights_(static_cast<Eigen::Index>(b), static_cast<Eigen::Index>(m)))
+                              * spectrum[b];
+                }
+            }
+            stft_.synthesize(output_, output);
+        }
+
+    private:
+        Complex* inverse(std::size_t bin) {
+            return inverses_.data() + bin * channels_ * channels_;
+        }
+
+        // u = P v, with P Hermitian stored row-major.
+        void multiply(const Complex* p, const Complex* v, Complex* u) const {
+            for (auto i = 0ul; i < channels_; ++i) {
+                auto sum = Complex(0.0f, 0.0f);
+                for (auto j = 0ul; j < channels_; ++j) {
+                    sum += p[i * channels_ + j] * v[j];
+                }
+                u[i] = sum;
+            }
+        }
+
+        // P = P - gain * u u^H
+        void downdate(Complex* p, const Complex* u, float gain) const {
+            for (auto i = 0ul; i < channels_; ++i) {
+                const auto scaled = gain * u[i];
+                for (auto j = 0ul; j < channels_; ++j) {
+                    p[i * channels_ + j] -= scaled * std::conj(u[j]);
+                }
+            }
+        }
+
+        // R' = l R + (1 - l) x x^H with ||x|| = 1, so R'^-1 = (P - b P x x^H P / (1 + b x^H P x)) / l, b = (1 - l) / l.
+        // The loading of one microphone per frame adds, on average, (1 - l) * Loading * I to R.
+        void update(const score::Matrix<Complex>& spectra) {
+            const auto beta = (1.0f - factor_) / factor_;
+            const auto loading = beta * Loading * static_cast<float>(channels_);
+            for (auto b = 0ul; b < bins_; ++b) {
+                auto energy = 0.0f;
+                for (auto m = 0ul; m < channels_; ++m) {
+                    snapshot_[m] = spectra(static_cast<Eigen::Index>(m), static_cast<Eigen::Index>(b));
+                    energy += std::norm(snapshot_[m]);
+                }
+                if (energy <= std::numeric_limits<float>::min()) {
+                    continue;
+                }
+
+                const auto normalization = 1.0f / std::sqrt(energy);
+                for (auto m = 0ul; m < channels_; ++m) {
+                    snapshot_[m] *= normalization;
+                }
+
+                auto* p = inverse(b);
+                multiply(p, snapshot_.data(), gain_.data());
+                auto quadratic = 0.0f;
+                for (auto m = 0ul; m < channels_; ++m) {
+                    quadratic += std::real(std::conj(snapshot_[m]) * gain_[m]);
+                }
+                downdate(p, gain_.data(), beta / (1.0f + beta * quadratic));
+
+                // Diagonal loading, one microphone per frame, keeps R invertible with coherent or stationary noise.
+                for (auto m = 0ul; m < channels_; ++m) {
+                    gain_[m] = p[m * channels_ + loaded_];
+                }
+                const auto diagonal = std::real(gain_[loaded_]);
+                downdate(p, gain_.data(), loading / (1.0f + loading * diagonal));
+
+                const auto forget = 1.0f / factor_;
+                for (auto i = 0ul, size = channels_ * channels_; i < size; ++i) {
+                    p[i] *= forget;
+                }
+            }
+            loaded_ = (loaded_ + 1) % channels_;
+            stale_ = true;
+        }
+
+        void computeWeights() {
+            // Steering vectors exp(-j w tau) of consecutive bins, computed with one rotation per microphone.
+            const auto step = 2 * M_PI * sample_rate_ / stft_.fftSize();
+            for (auto m = 0ul; m < channels_; ++m) {
+                steering_[m] = Complex(1.0f, 0.0f);
+                rotation_[m] = std::polar(1.0f, static_cast<float>(-step * delays_[m]));
+            }
+
+            for (auto b = 0ul; b < bins_; ++b) {
+                multiply(inverse(b), steering_.data(), gain_.data());
+                auto response = 0.0f;
+                for (auto m = 0ul; m < channels_; ++m) {
+                    response += std::real(std::conj(steering_[m]) * gain_[m]);
+                }
+                auto* weights = weights_.row(static_cast<Eigen::Index>(b)).data();
+                for (auto m = 0ul; m < channels_; ++m) {
+                    weights[m] = gain_[m] / response;
+                    steering_[m] *= rotation_[m];
+                }
+            }
+            stale_ = false;
+        }
+
+        static constexpr float Loading = 1e-3f;
+
+        std::int32_t sample_rate_;
+        std::size_t channels_;
+        std::size_t loaded_{0};
+        STFT stft_;
+        std::size_t bins_;
+        float factor_{0.98f};
+        bool stale_{true};
+        std::vector<Complex> inverses_;
+        std::vector<float> delays_;
+        score::Matrix<Complex> output_{};
+        score::Matrix<Complex> weights_{};
+        std::vector<Complex> steering_;
+        std::vector<Complex> rotation_;
+        std::vector<Complex> gain_;
+        std::vector<Complex> snapshot_;
+    };
+
+
+    using Spectra = Eigen::Array<std::complex<float>, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    /**
+     * Phasors exp(j w tau) that align every bin of every channel with the reference one, given the delay tau of every
+     * channel. They are computed with one rotation per channel, and only when the delays change.
+     */
+    class Alignment {
+    public:
+        Alignment(std::int32_t sample_rate, std::int8_t channels, std::size_t fft_size) :
+            sample_rate_(sample_rate),
+            fft_size_(fft_size),
+            delays_(static_cast<std::size_t>(channels), 0.0f) {
+            phasors_.resize(static_cast<Eigen::Index>(channels), static_cast<Eigen::Index>(fft_size / 2 + 1));
+        }
+
+        const Spectra& operator()(const float* delays) {
+            for (auto m = 0ul; m < delays_.size(); ++m) {
+                if (delays[m] != delays_[m]) {
+                    delays_[m] = delays[m];
+                    stale_ = true;
+                }
+            }
+
+            if (stale_) {
+                const auto step = 2 * M_PI * sample_rate_ / fft_size_;
+                for (auto m = 0; m < phasors_.rows(); ++m) {
+                    const auto rotation = std::polar(1.0f, static_cast<float>(step * delays_[m]));
+                    auto phasor = std::complex<float>(1.0f, 0.0f);
+                    for (auto b = 0; b < phasors_.cols(); ++b) {
+                        phasors_(m, b) = phasor;
+                        phasor *= rotation;
+                    }
+                }
+                stale_ = false;
+            }
+            return phasors_;
+        }
+
+    private:
+        std::int32_t sample_rate_;
+        std::size_t fft_size_;
+        bool stale_{true};
+        std::vector<float> delays_;
+        Spectra phasors_{};
+    };
+
+    /**
+     * Delay-and-sum beamformer with fractional delays, applied as phase shifts on a 50% overlap STFT. The history of
+     * the transform keeps the samples that the delays move across the edges of the frames.
+     */
+    class DelayAndSumFilter {
+    public:
+        DelayAndSumFilter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+                          std::size_t fft_size) :
+            channels_(channels),
+            stft_(channels, 2 * frames_per_channel, frames_per_channel, std::max(fft_size, 2 * frames_per_channel)),
+            alignment_(sample_rate, channels, stft_.fftSize()) {
+            output_.resize(1, static_cast<Eigen::Index>(stft_.bins()));
+        }
+
+        void reset() {
+            stft_.reset();
+        }
+
+        void process(const AudioBufferView& input, const float* delays, AudioBuffer& output) {
+            const auto& spectra = stft_.analyze(input);
+            output_.row(0) = ((alignment_(delays) * spectra.array()).colwise().sum()
+                              / static_cast<float>(channels_)).matrix();
+            stft_.synthesize(output_, output);
+        }
+
+    private:
+        std::int8_t channels_;
+        STFT stft_;
+        Alignment alignment_;
+        score::Matrix<std::complex<float>> output_{};
+    };
+
+    /**
+     * Bank of fixed delay-and-sum beams sharing a single STFT of the input channels.
+     *
+     * The output of every bin is y = W x, with one row of W per beam holding the alignment phasors of the channels
+     * scaled by 1 / M. The weights are stored as one row of bins per beam and channel, so the product of all bins is
+     * computed at once, one beam and channel at a time. The beams are synthesized with their own overlap, all of them
+     * or only the loudest one, which WOLA cross-fades over one frame when the selection changes.
+     */
+    class BeamBankFilter {
+    public:
+        BeamBankFilter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+                       std::size_t fft_size, const score::Matrix<float>& delays) :
+            channels_(static_cast<Eigen::Index>(channels)),
+            analysis_(channels, 2 * frames_per_channel, frames_per_channel,
+                      std::max(fft_size, 2 * frames_per_channel)),
+            synthesis_(static_cast<std::int8_t>(delays.rows()), 2 * frames_per_channel, frames_per_channel,
+                       analysis_.fftSize()) {
+
+            const auto beams = delays.rows();
+            const auto bins = static_cast<Eigen::Index>(analysis_.bins());
+            weights_.resize(beams * channels_, bins);
+            for (auto k = 0; k < beams; ++k) {
+                Alignment alignment(sample_rate, channels, analysis_.fftSize());
+                weights_.middleRows(k * channels_, channels_) = alignment(delays.row(k).data())
+                                                                / static_cast<float>(channels_);
+            }
+            beams_.resize(beams, bins);
+            selection_.resize(1, bins);
+            energies_.resize(beams);
+        }
+
+        void reset() {
+            analysis_.reset();
+            synthesis_.reset();
+            selected_ = 0;
+        }
+
+        std::size_t selected() const {
+            return selected_;
+        }
+
+        void process(const AudioBufferView& input, bool all, AudioBuffer& output) {
+            const auto& spectra = analysis_.analyze(input).array();
+            auto beams = beams_.array();
+            for (auto k = 0; k < beams.rows(); ++k) {
+                beams.row(k) = weights_.row(k * channels_) * spectra.row(0);
+                for (auto m = 1; m < channels_; ++m) {
+                    beams.row(k) += weights_.row(k * channels_ + m) * spectra.row(m);
+                }
+            }
+
+            // The selection only follows the loudest beam in frames that may contain speech.
+            if (input.type() != FrameType::Noise) {
+                energies_ = beams.abs2().rowwise().sum();
+                Eigen::Index loudest;
+                energies_.maxCoeff(&loudest);
+                selected_ = static_cast<std::size_t>(loudest);
+            }
+
+            if (all) {
+                synthesis_.synthesize(beams_, output);
+            } else {
+                selection_ = beams_.row(static_cast<Eigen::Index>(selected_));
+                synthesis_.synthesize(selection_, output);
+            }
+            output.setSampleRate(input.sampleRate());
+        }
+
+    private:
+        Eigen::Index channels_;
+        std::size_t selected_{0};
+        STFT analysis_;
+        STFT synthesis_;
+        Spectra weights_{};
+        score::Matrix<std::complex<float>> beams_{};
+        score::Matrix<std::complex<float>> selection_{};
+        Eigen::Array<float, Eigen::Dynamic, 1> energies_{};
+    };
+
+    /**
+     * Subband Generalized Sidelobe Canceller, processed with a 50% overlap STFT.
+     *
+     * Every bin is aligned towards the look direction, then a delay-and-sum beamformer gives the fixed beam and the
+     * differences of consecutive aligned channels, the blocking matrix, give M - 1 references without the target. An
+     * NLMS filter of one complex tap per bin and reference removes from the beam what the references predict, and is
+     * only adapted in frames without voice. All the bins of a channel are updated at once with Eigen expressions.
+     */
+    class GscFilter {
+    public:
+        using Complex = std::complex<float>;
+        using Spectrum = Eigen::Array<Complex, 1, Eigen::Dynamic>;
+
+        GscFilter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel,
+                  std::size_t fft_size, float step_size) :
+            channels_(static_cast<Eigen::Index>(channels)),
+            step_size_(step_size),
+            stft_(channels, 2 * frames_per_channel, frames_per_channel, std::max(fft_size, 2 * frames_per_channel)),
+            alignment_(sample_rate, channels, stft_.fftSize()) {
+
+            const auto bins = static_cast<Eigen::Index>(stft_.bins());
+            const auto references = std::max<Eigen::Index>(channels_ - 1, 0);
+            aligned_.resize(channels_, bins);
+            blocked_.resize(references, bins);
+            weights_.resize(references, bins);
+            power_.resize(bins);
+            beam_.resize(bins);
+            gain_.resize(bins);
+            output_.resize(1, bins);
+            reset();
+        }
+
+        void reset() {
+            weights_.setZero();
+            power_.setZero();
+            stft_.reset();
+        }
+
+        void process(const AudioBufferView& input, bool adapt, const float* delays, AudioBuffer& output) {
+            const auto& spectra = stft_.analyze(input);
+            aligned_ = alignment_(delays) * spectra.array();
+            beam_.matrix().noalias() = aligned_.matrix().colwise().sum() / static_cast<float>(channels_);
+            for (auto m = 0; m < blocked_.rows(); ++m) {
+                blocked_.row(m) = aligned_.row(m) - aligned_.row(m + 1);
+                beam_ -= weights_.row(m).conjugate() * blocked_.row(m);
+            }
+
+            // w = w + mu * z * conj(y) / P, with P the smoothed power of the references of every bin.
+            if (adapt && blocked_.rows() > 0) {
+                power_ = Smoothing * power_ + (1.0f - Smoothing) * blocked_.abs2().colwise().sum();
+                gain_ = beam_.conjugate() * (step_size_ / (power_ + Regularization));
+                for (auto m = 0; m < blocked_.rows(); ++m) {
+                    weights_.row(m) += blocked_.row(m) * gain_;
+                }
+            }
+
+            output_.row(0) = beam_.matrix();
+            stft_.synthesize(output_, output);
+        }
+
+    private:
+        static constexpr float Smoothing = 0.9f;
+        static constexpr float Regularization = 1e-6f;
+
+        Eigen::Index channels_;
+        float step_size_;
+        STFT stft_;
+        Alignment alignment_;
+        Spectra aligned_{};
+        Spectra blocked_{};
+        Spectra weights_{};
+        Eigen::Array<float, 1, Eigen::Dynamic> power_{};
+        Spectrum beam_{};
+        Spectrum gain_{};
+        score::Matrix<Complex> output_{};
+    };
+
+}
+
 struct Beamformer::Pimpl {
 
     Pimpl(std::int32_t sample_rate,
@@ -34,20 +465,35 @@ struct Beamformer::Pimpl {
         sample_rate_(sample_rate),
         channels_(channels),
         frames_per_buffer_(frames_per_channel),
-        nfft_(nextPowerOfTwo(frames_per_channel)),
+        nfft_(nextPowerOfTwo(2 * frames_per_channel)),
         learning_rate_(learning_rate),
         reference_(reference),
         indexes_(channels, 0),
         tdoas_(channels, 0),
-        gsc_(channels, frames_per_channel, learning_rate_),
-        mvdr_(sample_rate, nfft_,  channels),
-        margin_(20)
+        margin_(20),
+        gcc_(channels, frames_per_channel),
+        packed_(sample_rate, channels, frames_per_channel)
         {
-
+        // The fractional methods align the channels with the refined delays, DelayAndSum rounds them.
+        gcc_.setInterpolation(GccPhat::BandLimited);
     }
 
+    // The beam-forming algorithms expect the channels one after the other in a single block of memory.
+    const float* pack(const AudioBufferView& input) {
+        auto packed = input.isContiguous();
+        for (auto i = 1; packed && i < input.channels(); ++i) {
+            packed = input.channel(i) == input.channel(0) + i * input.framesPerChannel();
+        }
+
+        if (packed) {
+            return input.channel(0);
+        }
+
+        input.copyTo(packed_);
+        return packed_.data();
+    }
 
-    void procees(const AudioBuffer& input, AudioBuffer& output) {
+    void procees(const AudioBufferView& input, AudioBuffer& output) {
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
                                         + std::to_string(sample_rate_) + " Hz");
@@ -63,11 +509,13 @@ struct Beamformer::Pimpl {
                                         + std::to_string(frames_per_buffer_) + " samples per channel.");
         }
 
-        if (!ignore_toa_) {
-            GccPhatTdoa(input.data(), input.channels(), static_cast<int>(input.framesPerChannel()),
-                        reference_, margin_, indexes_.data());
-            for (auto i = 0ul; i < channels_; ++i)
-                tdoas_[i] = static_cast<float>(indexes_[i]) / static_cast<float>(sample_rate_);
+        if (!ignore_toa_ && !steered_ && method_ != Method::BeamBank) {
+            gcc_.analyze(input);
+            for (auto i = 0ul; i < channels_; ++i) {
+                const auto peak = i == reference_ ? GccPhat::Peak{0, 0, 0} : gcc_.correlate(i, reference_, margin_);
+                indexes_[i] = peak.lag;
+                tdoas_[i] = peak.delay / static_cast<float>(sample_rate_);
+            }
         }
 
         output.setSampleRate(input.sampleRate());
@@ -75,30 +523,110 @@ struct Beamformer::Pimpl {
 
         switch (method_) {
             case Method::DelayAndSum:
-                ::DelayAndSum(input.data(), input.channels(), input.framesPerChannel(),
+                ::DelayAndSum(pack(input), input.channels(), input.framesPerChannel(),
                         indexes_.data(), output.data());
                 break;
+            case Method::FractionalDelayAndSum:
+                if (!fractional_) {
+                    fractional_ = std::make_unique<DelayAndSumFilter>(sample_rate_, channels_, frames_per_buffer_,
+                                                                      nfft_);
+                }
+                fractional_->process(input, tdoas_.data(), output);
+                break;
+            case Method::BeamBank:
+                if (!bank_) {
+                    if (beams_.size() == 0) {
+                        throw std::runtime_error("The directions of the beams are not configured.");
+                    }
+                    bank_ = std::make_unique<BeamBankFilter>(sample_rate_, channels_, frames_per_buffer_, nfft_,
+                                                             beams_);
+                }
+                bank_->process(input, selection_ == BeamSelection::AllBeams, output);
+                break;
             case Method::MVDR:
-                mvdr_.DoBeamformimg(input.data(),
-                                    input.size(),
-                                    input.type() < FrameType::Voice,
-                                    tdoas_.data(),
-                                    output.data());
+                if (!mvdr_) {
+                    mvdr_ = std::make_unique<MvdrFilter>(sample_rate_, channels_, frames_per_buffer_, nfft_);
+                    mvdr_->setForgettingFactor(forgetting_factor_);
+                }
+                mvdr_->process(input, input.type() != FrameType::Voice, tdoas_.data(), output);
                 break;
             case Method::GSC:
-                gsc_.DoBeamformimg(input.data(), input.size(), output.data());
+                if (!gsc_) {
+                    gsc_ = std::make_unique<GscFilter>(sample_rate_, channels_, frames_per_buffer_, nfft_,
+                                                       learning_rate_);
+                }
+                gsc_->process(input, input.type() != FrameType::Voice, tdoas_.data(), output);
                 break;
         }
     }
 
     void ignoreTimeDelays(bool ignore) {
         ignore_toa_ = ignore;
+        steered_ = false;
         if (ignore_toa_) {
             std::fill(std::begin(indexes_), std::end(indexes_), 0);
             std::fill(std::begin(tdoas_), std::end(tdoas_), 0);
         }
     }
 
+    void setGeometry(const ArrayGeometry& geometry, float sound_speed) {
+        if (geometry.size() != static_cast<std::size_t>(channels_)) {
+            throw std::invalid_argument("Expected a geometry of " + std::to_string(channels_) + " microphones.");
+        }
+
+        geometry_ = std::make_unique<ArrayGeometry>(geometry);
+        sound_speed_ = sound_speed;
+        steered_ = false;
+
+        // Scaled offsets of every microphone to the reference one, so steering only needs the direction.
+        const auto& origin = geometry[static_cast<std::size_t>(reference_)];
+        offsets_.resize(channels_, 3);
+        for (auto i = 0; i < channels_; ++i) {
+            const auto& position = geometry[static_cast<std::size_t>(i)];
+            for (auto k = 0; k < 3; ++k) {
+                offsets_(i, k) = static_cast<float>(-(position[k] - origin[k]) / sound_speed);
+            }
+        }
+    }
+
+    void steer(float azimuth, float elevation) {
+        if (!geometry_) {
+            throw std::runtime_error("The geometry of the array is not configured.");
+        }
+
+        if (steered_ && azimuth == azimuth_ && elevation == elevation_) {
+            return;
+        }
+
+        // Delay of every channel with respect to the reference one, as in ArrayGeometry::arrivalDelays.
+        const auto el = elevation * static_cast<float>(M_PI / 180.0);
+        const auto az = azimuth * static_cast<float>(M_PI / 180.0);
+        const Eigen::Vector3f direction(std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el));
+        for (auto i = 0; i < channels_; ++i) {
+            tdoas_[i] = offsets_.row(i).dot(direction);
+            indexes_[i] = static_cast<int>(std::lround(tdoas_[i] * static_cast<float>(sample_rate_)));
+        }
+        azimuth_ = azimuth;
+        elevation_ = elevation;
+        steered_ = true;
+    }
+
+    void setBeams(const std::vector<float>& azimuths, float elevation) {
+        if (!geometry_) {
+            throw std::runtime_error("The geometry of the array is not configured.");
+        }
+
+        if (azimuths.empty() || azimuths.size() > std::numeric_limits<std::int8_t>::max()) {
+            throw std::invalid_argument("Expected between 1 and "
+                                        + std::to_string(std::numeric_limits<std::int8_t>::max()) + " beams.");
+        }
+
+        // Delay of every channel with respect to the reference one, one row per beam.
+        beams_ = geometry_->arrivalDelays(azimuths, {elevation}, sound_speed_);
+        beams_.colwise() -= Eigen::VectorXf(beams_.col(reference_));
+        bank_.reset();
+    }
+
     void setMargin(std::int32_t margin) {
         if (margin > frames_per_buffer_ / 2) {
             throw std::runtime_error("Maximum allowed margin: "
@@ -108,6 +636,12 @@ struct Beamformer::Pimpl {
     }
 
     bool ignore_toa_{false};
+    bool steered_{false};
+    std::unique_ptr<ArrayGeometry> geometry_{nullptr};
+    float sound_speed_{343.2f};
+    Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> offsets_{};
+    float azimuth_{0};
+    float elevation_{0};
     Method method_{Method::DelayAndSum};
     std::int32_t sample_rate_;
     std::int8_t channels_;
@@ -116,16 +650,55 @@ struct Beamformer::Pimpl {
     std::int8_t reference_;
     std::int32_t margin_;
     float learning_rate_;
-    Mvdr mvdr_;
-    Gsc gsc_;
+    float forgetting_factor_{0.98f};
+    Matrix<float> beams_{};
+    BeamSelection selection_{BeamSelection::LoudestBeam};
+    std::unique_ptr<BeamBankFilter> bank_{nullptr};
+    std::unique_ptr<DelayAndSumFilter> fractional_{nullptr};
+    std::unique_ptr<MvdrFilter> mvdr_{nullptr};
+    std::unique_ptr<GscFilter> gsc_{nullptr};
     std::vector<int> indexes_;
     std::vector<float> tdoas_;
+    GccPhat gcc_;
+    AudioBuffer packed_;
 };
 
-void score::Beamformer::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::Beamformer::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->procees(input, output);
 }
 
+void score::Beamformer::setGeometry(const ArrayGeometry &geometry, float sound_speed) {
+    pimpl_->setGeometry(geometry, sound_speed);
+}
+
+void score::Beamformer::steer(float azimuth, float elevation) {
+    pimpl_->steer(azimuth, elevation);
+}
+
+bool score::Beamformer::isSteered() const {
+    return pimpl_->steered_;
+}
+
+void score::Beamformer::setBeams(const std::vector<float> &azimuths, float elevation) {
+    pimpl_->setBeams(azimuths, elevation);
+}
+
+std::size_t score::Beamformer::beams() const {
+    return static_cast<std::size_t>(pimpl_->beams_.rows());
+}
+
+void score::Beamformer::setBeamSelection(Beamformer::BeamSelection selection) {
+    pimpl_->selection_ = selection;
+}
+
+Beamformer::BeamSelection score::Beamformer::beamSelection() const {
+    return pimpl_->selection_;
+}
+
+std::size_t score::Beamformer::selectedBeam() const {
+    return pimpl_->bank_ ? pimpl_->bank_->selected() : 0;
+}
+
 void score::Beamformer::setMethod(Beamformer::Method method) {
     pimpl_->method_ = method;
 }
@@ -151,6 +724,35 @@ void score::Beamformer::setFFTSize(std::size_t nfft) {
         throw std::runtime_error("The minimum size should be: " + std::to_string(pimpl_->frames_per_buffer_));
     }
     pimpl_->nfft_ = nextPowerOfTwo(nfft);
+    pimpl_->bank_.reset();
+    pimpl_->fractional_.reset();
+    pimpl_->mvdr_.reset();
+    pimpl_->gsc_.reset();
+}
+
+void score::Beamformer::setForgettingFactor(float factor) {
+    if (factor <= 0 || factor >= 1) {
+        throw std::invalid_argument("Expected a forgetting factor in the range (0, 1).");
+    }
+    pimpl_->forgetting_factor_ = factor;
+    if (pimpl_->mvdr_) {
+        pimpl_->mvdr_->setForgettingFactor(factor);
+    }
+}
+
+void score::Beamformer::reset() {
+    if (pimpl_->bank_) {
+        pimpl_->bank_->reset();
+    }
+    if (pimpl_->fractional_) {
+        pimpl_->fractional_->reset();
+    }
+    if (pimpl_->mvdr_) {
+        pimpl_->mvdr_->reset();
+    }
+    if (pimpl_->gsc_) {
+        pimpl_->gsc_->reset();
+    }
 }
 
 void score::Beamformer::ignoreTimeDelays(bool ignore) {
@@ -1,5 +1,6 @@
 #include "channel_remove.hpp"
 #include <unordered_set>
+#include <numeric>
 #include <channel_remove.hpp>
 
 
@@ -8,8 +9,9 @@ using namespace score;
 struct ChannelRemove::Pimpl {
 
     explicit Pimpl(std::uint8_t channels) :
-        channels_(channels) {
-
+        channels_(channels),
+        selected_(channels) {
+        std::iota(std::begin(selected_), std::end(selected_), 0);
     }
 
 
@@ -17,21 +19,27 @@ struct ChannelRemove::Pimpl {
         if (index < channels_) {
             ignored_.insert(index);
         }
+
+        selected_.clear();
+        for (auto i = 0ul; i < channels_; ++i) {
+            if (ignored_.find(i) == ignored_.end()) {
+                selected_.push_back(i);
+            }
+        }
+    }
+
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        process(input, view_);
+        view_.copyTo(output);
     }
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBufferView& output) {
         if (channels_ != input.channels()) {
             throw std::invalid_argument("The block is configured to work with "
                                         + std::to_string(channels_) + " channels.");
         }
 
-        output.setSampleRate(input.sampleRate());
-        output.resize(remaining(), input.framesPerChannel());
-        for (auto i = 0ul, inserted = 0ul; i < channels_; ++i) {
-            if (ignored_.find(i) == ignored_.end()) {
-                std::copy(input.channel(i), input.channel(i) + input.framesPerChannel(), output.channel(inserted++));
-            }
-        }
+        output = input.select(selected_);
     }
 
     std::size_t remaining() {
@@ -40,6 +48,8 @@ struct ChannelRemove::Pimpl {
 
     std::uint8_t channels_{};
     std::unordered_set<std::size_t> ignored_{};
+    std::vector<std::size_t> selected_{};
+    AudioBufferView view_{};
 };
 
 score::ChannelRemove::ChannelRemove(std::uint8_t channels) :
@@ -51,7 +61,11 @@ void score::ChannelRemove::ignore(std::uint8_t index) {
     pimpl_->ignore(index);
 }
 
-void score::ChannelRemove::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::ChannelRemove::process(const AudioBufferView &input, AudioBuffer &output) {
+    pimpl_->process(input, output);
+}
+
+void score::ChannelRemove::process(const AudioBufferView &input, AudioBufferView &output) {
     pimpl_->process(input, output);
 }
 
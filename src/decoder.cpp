@@ -18,7 +18,7 @@ struct Decoder::Pimpl {
 
     void process(AudioBuffer &output, std::size_t size) {
 
-        interleave_.resize(size);
+        interleave_.resize(size * static_cast<std::size_t>(decoder_.channels()));
         decoder_.read(std::begin(interleave_), std::end(interleave_));
 
         output.setSampleRate(decoder_.samplerate());
@@ -9,17 +9,17 @@ struct Delay::Pimpl {
 
     }
 
-    void delaySequence(const float *in_data, std::size_t num, int delay, float *out_data) {
+    void delaySequence(const float *in_data, std::size_t num, std::size_t stride, int delay, float *out_data) {
         for (int i = 0; i < num; i++) {
             if (i - delay >= 0 && i - delay < num) {
-                out_data[i] = in_data[i - delay];
+                out_data[i] = in_data[(i - delay) * stride];
             } else {
                 out_data[i] = 0;
             }
         }
     }
 
-    void process(const score::AudioBuffer &input, score::AudioBuffer &output) {
+    void process(const score::AudioBufferView &input, score::AudioBuffer &output) {
         if (sample_rate_ != input.sampleRate()) {
             throw std::invalid_argument("The block is configured to work with "
                                         + std::to_string(sample_rate_) + " Hz.");
@@ -29,7 +29,7 @@ struct Delay::Pimpl {
         output.resize(input.channels(), input.framesPerChannel());
 
         for (auto i = 0ul; i < input.channels(); ++i) {
-            delaySequence(input.channel(i), input.framesPerChannel(), delay_samples_, output.channel(i));
+            delaySequence(input.channel(i), input.framesPerChannel(), input.stride(), delay_samples_, output.channel(i));
         }
     }
 
@@ -47,6 +47,6 @@ score::Delay::Delay(std::int32_t sample_rate, std::int32_t delay) :
 
 }
 
-void score::Delay::process(const score::AudioBuffer &input, score::AudioBuffer &output) {
+void score::Delay::process(const score::AudioBufferView &input, score::AudioBuffer &output) {
     pimpl_->process(input, output);
 }
@@ -0,0 +1,229 @@
+#include "delay_aligner.hpp"
+#include "ring_buffer.hpp"
+#include "stft.hpp"
+#include <modules/audio_processing/utility/delay_estimator_wrapper.h>
+
+#include <cmath>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    // The estimator matches the bits 12 to 43 of the binary spectra.
+    constexpr std::size_t MinimumBins = 44;
+
+    // As the legacy WebRTC AEC, an estimation is trusted if it is at least as reliable as the previous ones, up to
+    // this quality.
+    constexpr float MaximumQualityThreshold = 0.07f;
+
+    // Halves the frame while the blocks keep at least 64 samples, so the delay is estimated in steps of 4-8 ms.
+    std::size_t blockSizeOf(std::size_t frame_size) {
+        auto block_size = frame_size;
+        while (block_size % 2 == 0 && block_size / 2 >= 64) {
+            block_size /= 2;
+        }
+        return block_size;
+    }
+
+}
+
+struct DelayAligner::Pimpl {
+
+    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, std::size_t max_delay) :
+        sample_rate_(sample_rate),
+        channels_(channels),
+        frame_size_(frame_size),
+        block_size_(blockSizeOf(frame_size)),
+        max_delay_(max_delay),
+        stft_(2, 2 * block_size_, block_size_),
+        block_(sample_rate, 2, block_size_),
+        far_spectrum_(stft_.bins()),
+        near_spectrum_(stft_.bins()) {
+
+        if (channels_ <= 0 || frame_size_ == 0 || frame_size_ > 0.02 * sample_rate_) {
+            throw std::invalid_argument("Expected a positive number of channels and frames of 10-20 ms.");
+        }
+
+        if (stft_.bins() < MinimumBins) {
+            throw std::invalid_argument("Expected frames of at least " + std::to_string(2 * (MinimumBins - 1))
+                                        + " samples.");
+        }
+
+        const auto history = static_cast<int>(max_delay_ / block_size_ + 2);
+        far_ = WebRtc_CreateDelayEstimatorFarend(static_cast<int>(stft_.bins()), history);
+        if (far_ == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        near_ = WebRtc_CreateDelayEstimator(far_, 0);
+        if (near_ == nullptr) {
+            WebRtc_FreeDelayEstimatorFarend(far_);
+            throw std::bad_alloc();
+        }
+
+        for (auto i = 0; i < channels_; ++i) {
+            history_.push_back(std::make_unique<RingBuffer<float>>(max_delay_ + frame_size_));
+        }
+        reset();
+    }
+
+    ~Pimpl() {
+        WebRtc_FreeDelayEstimator(near_);
+        WebRtc_FreeDelayEstimatorFarend(far_);
+    }
+
+    void reset() {
+        WebRtc_InitDelayEstimatorFarend(far_);
+        WebRtc_InitDelayEstimator(near_);
+        // The robust validation takes several seconds to follow a change of the delay.
+        WebRtc_enable_robust_validation(near_, 0);
+        stft_.reset();
+        delay_ = 0;
+        quality_ = 0;
+        threshold_ = 0;
+
+        // Starts with max_delay of silence already consumed, so that the delay can grow from the first frame.
+        const std::vector<float> silence(max_delay_, 0.0f);
+        for (auto& history : history_) {
+            history->reset();
+            history->write(silence.data(), silence.size());
+            history->discard(silence.size());
+        }
+    }
+
+    void process(const AudioBufferView& recorded, const AudioBufferView& played, AudioBuffer& aligned) {
+        if (!played.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
+        if (recorded.sampleRate() != sample_rate_ || played.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected " + std::to_string(sample_rate_) + " Hz");
+        }
+
+        if (played.channels() != channels_ || recorded.channels() <= 0) {
+            throw std::invalid_argument("The DelayAligner is configure to work with "
+                                        + std::to_string(channels_) + " play channels.");
+        }
+
+        if (recorded.framesPerChannel() != frame_size_ || played.framesPerChannel() != frame_size_) {
+            throw std::invalid_argument("The DelayAligner is configure to work with " + std::to_string(frame_size_)
+                                        + " frames per buffer.");
+        }
+
+        auto estimation = -1;
+        for (auto offset = 0ul; offset < frame_size_; offset += block_size_) {
+            downmix(played, offset, block_.channel(0));
+            downmix(recorded, offset, block_.channel(1));
+            const auto& spectra = stft_.analyze(block_);
+            for (auto k = 0ul; k < far_spectrum_.size(); ++k) {
+                far_spectrum_[k] = std::abs(spectra(0, static_cast<Eigen::Index>(k)));
+                near_spectrum_[k] = std::abs(spectra(1, static_cast<Eigen::Index>(k)));
+            }
+
+            const auto bins = static_cast<int>(far_spectrum_.size());
+            WebRtc_AddFarSpectrumFloat(far_, far_spectrum_.data(), bins);
+            const auto blocks = WebRtc_DelayEstimatorProcessFloat(near_, near_spectrum_.data(), bins);
+            if (blocks >= 0) {
+                quality_ = WebRtc_last_delay_quality(near_);
+                if (quality_ > threshold_) {
+                    threshold_ = std::min(quality_, MaximumQualityThreshold);
+                    estimation = blocks;
+                }
+            }
+        }
+
+        if (estimation >= 0) {
+            update(static_cast<std::size_t>(estimation) * block_size_);
+        }
+
+        aligned.setSampleRate(sample_rate_);
+        aligned.resize(channels_, frame_size_);
+        for (auto i = 0; i < channels_; ++i) {
+            auto& history = *history_[static_cast<std::size_t>(i)];
+            history.write(played.channel(static_cast<std::size_t>(i)), frame_size_);
+            history.read(aligned.channel(static_cast<std::size_t>(i)), frame_size_);
+        }
+    }
+
+    std::int32_t sample_rate_;
+    std::int8_t channels_;
+    std::size_t frame_size_;
+    std::size_t block_size_;
+    std::size_t max_delay_;
+    std::size_t delay_{0};
+    float quality_{0};
+
+private:
+
+    void downmix(const AudioBufferView& input, std::size_t offset, float* output) const {
+        const auto scale = 1.0f / static_cast<float>(input.channels());
+        for (auto n = 0ul; n < block_size_; ++n) {
+            auto sum = 0.0f;
+            for (auto i = 0ul; i < input.channels(); ++i) {
+                sum += input(i, offset + n);
+            }
+            output[n] = sum * scale;
+        }
+    }
+
+    // Keeps one block of headroom, and ignores changes within a block to avoid moving the signal back and forth.
+    void update(std::size_t estimation) {
+        const auto target = std::min(estimation > block_size_ ? estimation - block_size_ : 0, max_delay_);
+        const auto change = target > delay_ ? target - delay_ : delay_ - target;
+        if (change <= block_size_) {
+            return;
+        }
+
+        for (auto& history : history_) {
+            if (target > delay_) {
+                history->rewind(target - delay_);
+            } else {
+                history->discard(delay_ - target);
+            }
+        }
+        delay_ = target;
+    }
+
+    float threshold_{0};
+    STFT stft_;
+    AudioBuffer block_;
+    std::vector<float> far_spectrum_;
+    std::vector<float> near_spectrum_;
+    std::vector<std::unique_ptr<RingBuffer<float>>> history_{};
+    void* far_{nullptr};
+    void* near_{nullptr};
+};
+
+score::DelayAligner::DelayAligner(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size,
+        std::size_t max_delay) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, frame_size, max_delay)) {
+
+}
+
+score::DelayAligner::~DelayAligner() = default;
+
+std::size_t score::DelayAligner::blockSize() const {
+    return pimpl_->block_size_;
+}
+
+std::size_t score::DelayAligner::maxDelay() const {
+    return pimpl_->max_delay_;
+}
+
+std::size_t score::DelayAligner::delay() const {
+    return pimpl_->delay_;
+}
+
+float score::DelayAligner::quality() const {
+    return pimpl_->quality_;
+}
+
+void score::DelayAligner::process(const AudioBufferView &recorded, const AudioBufferView &played,
+        AudioBuffer &aligned) {
+    pimpl_->process(recorded, played, aligned);
+}
+
+void score::DelayAligner::reset() {
+    pimpl_->reset();
+}
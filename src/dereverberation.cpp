@@ -14,7 +14,7 @@ struct Handler {
         }
 
 
-        state_ = speex_preprocess_state_init(static_cast<int>(sample_rate), static_cast<int>(frame_size));
+        state_ = speex_preprocess_state_init(static_cast<int>(frame_size), static_cast<int>(sample_rate));
         if (state_ == nullptr) {
             throw std::bad_alloc();
         }
@@ -24,7 +24,7 @@ struct Handler {
         speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_DENOISE, &disable);
         speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_DEREVERB, &enable);
         speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_VAD, &disable);
-        speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_ECHO_STATE, &disable);
+        speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_ECHO_STATE, nullptr);
     }
 
     ~Handler() {
@@ -40,27 +40,37 @@ struct Handler {
 
 struct DeReverberation::Pimpl {
 
+    // Cost in nanoseconds per sample, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSample = 100ul;
+
     Pimpl(std::int32_t sample_rate,
           std::int8_t channels,
           std::size_t frame_size) :
             sample_rate_(sample_rate),
             channels_(channels),
-            temp_(frame_size),
-            handlers_(static_cast<unsigned long>(channels), Handler(sample_rate, frame_size))
+            temp_(channels, frame_size),
+            handlers_(static_cast<unsigned long>(channels))
 
     {
+        for (auto& handler : handlers_) {
+            handler = std::make_unique<Handler>(sample_rate, frame_size);
+        }
 
     }
 
     void reset() {
         for (auto& h : handlers_) {
-            h.reset();
+            h->reset();
         }
 
     }
 
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
@@ -72,46 +82,57 @@ struct DeReverberation::Pimpl {
                                         + std::to_string(channels_) + " channels.");
         }
 
-        if (input.framesPerChannel() != temp_.size()) {
-            throw std::invalid_argument("The DeReverberation is configure to work with " + std::to_string(temp_.size())
+        if (input.framesPerChannel() != temp_.cols()) {
+            throw std::invalid_argument("The DeReverberation is configure to work with " + std::to_string(temp_.cols())
                                         + " frames per buffer.");
         }
 
         input.copyTo(output);
-        for (auto i = 0ul; i < channels_; ++i) {
-            Converter::FloatS16ToS16(input.channel(i), input.framesPerChannel(), temp_.data());
-            speex_preprocess_run(handlers_[i].state_, temp_.data());
-            Converter::S16ToFloatS16(temp_.data(), output.framesPerChannel(), output.channel(i));
+        const auto process_channel = [&](std::size_t i) {
+            auto* temp = temp_.row(i).data();
+            Converter::FloatS16ToS16(input.channel(i), input.framesPerChannel(), temp);
+            speex_preprocess_run(handlers_[i]->state_, temp);
+            Converter::S16ToFloatS16(temp, output.framesPerChannel(), output.channel(i));
+        };
+
+        if (pool_ && ThreadPool::isWorthDispatching(input.size() * CostPerSample)) {
+            pool_->parallelFor(channels_, process_channel);
+        } else {
+            for (auto i = 0ul; i < channels_; ++i) {
+                process_channel(i);
+            }
         }
     }
 
     void setLevel(int level_db) {
         for (auto& h : handlers_) {
-            speex_preprocess_ctl(h.state_, SPEEX_PREPROCESS_SET_DEREVERB_LEVEL, &level_db);
+            speex_preprocess_ctl(h->state_, SPEEX_PREPROCESS_SET_DEREVERB_LEVEL, &level_db);
         }
     }
 
     void setDecay(int decay) {
         for (auto& h : handlers_) {
-            speex_preprocess_ctl(h.state_, SPEEX_PREPROCESS_SET_DEREVERB_DECAY, &decay);
+            speex_preprocess_ctl(h->state_, SPEEX_PREPROCESS_SET_DEREVERB_DECAY, &decay);
         }
     }
 
     int level() const {
         int level_db = 0;
-        speex_preprocess_ctl(handlers_.front().state_, SPEEX_PREPROCESS_GET_DEREVERB_LEVEL, &level_db);
+        speex_preprocess_ctl(handlers_.front()->state_, SPEEX_PREPROCESS_GET_DEREVERB_LEVEL, &level_db);
         return level_db;
     }
 
     int decay() const {
         int decay = 0;
-        speex_preprocess_ctl(handlers_.front().state_, SPEEX_PREPROCESS_GET_DEREVERB_DECAY, &decay);
+        speex_preprocess_ctl(handlers_.front()->state_, SPEEX_PREPROCESS_GET_DEREVERB_DECAY, &decay);
         return decay;
     }
 
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+
 private:
-    std::vector<Handler> handlers_;
-    std::vector<std::int16_t> temp_;
+    std::vector<std::unique_ptr<Handler>> handlers_;
+    Matrix<std::int16_t> temp_;
     std::int32_t sample_rate_;
     std::int8_t channels_;
 };
@@ -138,8 +159,12 @@ void score::DeReverberation::setDecay(int decay) {
 
 }
 
-void score::DeReverberation::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::DeReverberation::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
+void score::DeReverberation::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
 score::DeReverberation::~DeReverberation() = default;
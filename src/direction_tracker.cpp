@@ -0,0 +1,333 @@
+#include "direction_tracker.hpp"
+#include "doa.hpp"
+#include "music.hpp"
+#include "srp_phat.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    // Difference between two angles in the range [-180, 180).
+    float wrap(float angle) {
+        angle = std::fmod(angle + 180.0f, 360.0f);
+        return (angle < 0 ? angle + 360.0f : angle) - 180.0f;
+    }
+
+    float normalize(float azimuth) {
+        return wrap(azimuth - 180.0f) + 180.0f;
+    }
+
+    /**
+     * Constant-velocity Kalman filter over the azimuth. The covariance is symmetric, only three terms are kept.
+     */
+    struct Filter {
+        std::size_t id{0};
+        float azimuth{0};
+        float velocity{0};
+        float p00{0};
+        float p01{0};
+        float p11{0};
+        std::size_t hits{0};
+        std::size_t misses{0};
+        double idle{0};
+
+        void predict(float elapsed, float acceleration) {
+            const auto dt = elapsed;
+            const auto q = acceleration * acceleration;
+            azimuth = normalize(azimuth + velocity * dt);
+            p00 += 2 * dt * p01 + dt * dt * p11 + q * dt * dt * dt * dt / 4;
+            p01 += dt * p11 + q * dt * dt * dt / 2;
+            p11 += q * dt * dt;
+        }
+
+        float innovation(float observation, float measurement) const {
+            const auto residual = wrap(observation - azimuth);
+            return residual * residual / (p00 + measurement * measurement);
+        }
+
+        void correct(float observation, float measurement) {
+            const auto residual = wrap(observation - azimuth);
+            const auto s = p00 + measurement * measurement;
+            const auto k0 = p00 / s;
+            const auto k1 = p01 / s;
+            azimuth = normalize(azimuth + k0 * residual);
+            velocity += k1 * residual;
+            p11 -= k1 * p01;
+            p01 *= 1 - k0;
+            p00 *= 1 - k0;
+        }
+    };
+
+    struct Candidate {
+        float distance;
+        std::size_t track;
+        std::size_t observation;
+    };
+
+}
+
+struct DirectionTracker::Pimpl {
+
+    Pimpl() {
+        setMaximumTracks(4);
+    }
+
+    void setMaximumTracks(std::size_t tracks) {
+        if (tracks == 0) {
+            throw std::invalid_argument("Expected at least one track.");
+        }
+
+        maximum_tracks_ = tracks;
+        filters_.reserve(tracks);
+        confirmed_.reserve(tracks);
+        assigned_.reserve(tracks);
+    }
+
+    const std::vector<Track>& process(const AudioBufferView& input, bool speech) {
+        const auto elapsed = static_cast<double>(input.framesPerChannel()) / input.sampleRate();
+        if (!speech || !localizer_) {
+            return predict(elapsed);
+        }
+
+        observations_.clear();
+        localizer_(input, observations_);
+        ++localizations_;
+        return update(observations_, elapsed);
+    }
+
+    const std::vector<Track>& predict(double elapsed) {
+        for (auto& filter : filters_) {
+            filter.predict(static_cast<float>(elapsed), acceleration_);
+            filter.idle += elapsed;
+        }
+        terminate();
+        return publish();
+    }
+
+    const std::vector<Track>& update(const std::vector<Observation>& observations, double elapsed) {
+        for (auto& filter : filters_) {
+            filter.predict(static_cast<float>(elapsed), acceleration_);
+            filter.idle += elapsed;
+        }
+
+        // Global nearest neighbour, solved greedily: the closest pairs inside the gate are assigned first.
+        candidates_.clear();
+        for (auto t = 0ul; t < filters_.size(); ++t) {
+            for (auto o = 0ul; o < observations.size(); ++o) {
+                const auto distance = filters_[t].innovation(observations[o].azimuth, measurement_);
+                if (distance <= gate_ * gate_) {
+                    candidates_.push_back({distance, t, o});
+                }
+            }
+        }
+        std::sort(candidates_.begin(), candidates_.end(), [](const Candidate& left, const Candidate& right) {
+            return left.distance < right.distance;
+        });
+
+        assigned_.assign(filters_.size(), false);
+        used_.assign(observations.size(), false);
+        for (const auto& candidate : candidates_) {
+            if (assigned_[candidate.track] || used_[candidate.observation]) {
+                continue;
+            }
+            auto& filter = filters_[candidate.track];
+            filter.correct(observations[candidate.observation].azimuth, measurement_);
+            filter.hits++;
+            filter.misses = 0;
+            filter.idle = 0;
+            assigned_[candidate.track] = true;
+            used_[candidate.observation] = true;
+        }
+
+        for (auto t = 0ul; t < filters_.size(); ++t) {
+            if (!assigned_[t]) {
+                filters_[t].misses++;
+            }
+        }
+
+        for (auto o = 0ul; o < observations.size() && filters_.size() < maximum_tracks_; ++o) {
+            if (!used_[o] && observations[o].power >= birth_threshold_) {
+                Filter filter;
+                filter.id = next_id_++;
+                filter.azimuth = normalize(observations[o].azimuth);
+                filter.p00 = measurement_ * measurement_;
+                filter.p11 = InitialVelocity * InitialVelocity;
+                filter.hits = 1;
+                filters_.push_back(filter);
+            }
+        }
+
+        terminate();
+        return publish();
+    }
+
+    void terminate() {
+        // Tentative tracks die as soon as they miss more frames than the ones needed to confirm them.
+        const auto dead = [this](const Filter& filter) {
+            const auto misses = filter.hits < confirmation_ ? confirmation_ : maximum_misses_;
+            return filter.misses >= misses || filter.idle >= timeout_;
+        };
+        filters_.erase(std::remove_if(filters_.begin(), filters_.end(), dead), filters_.end());
+
+        // Two tracks following the same source are merged into the oldest one.
+        for (auto i = 0ul; i < filters_.size(); ++i) {
+            for (auto j = i + 1; j < filters_.size();) {
+                if (std::abs(wrap(filters_[i].azimuth - filters_[j].azimuth)) < measurement_) {
+                    filters_[i].hits = std::max(filters_[i].hits, filters_[j].hits);
+                    filters_.erase(filters_.begin() + static_cast<std::ptrdiff_t>(j));
+                } else {
+                    ++j;
+                }
+            }
+        }
+    }
+
+    const std::vector<Track>& publish() {
+        confirmed_.clear();
+        for (const auto& filter : filters_) {
+            if (filter.hits >= confirmation_) {
+                confirmed_.push_back({filter.id, filter.azimuth, filter.velocity, std::sqrt(filter.p00),
+                                      filter.hits, filter.idle});
+            }
+        }
+        return confirmed_;
+    }
+
+    void reset() {
+        filters_.clear();
+        confirmed_.clear();
+        localizations_ = 0;
+    }
+
+    static constexpr float InitialVelocity = 30.0f;
+
+    Localizer localizer_{};
+    std::vector<Filter> filters_{};
+    std::vector<Track> confirmed_{};
+    std::vector<Observation> observations_{};
+    std::vector<Candidate> candidates_{};
+    std::vector<bool> assigned_{};
+    std::vector<bool> used_{};
+    float acceleration_{20.0f};
+    float measurement_{5.0f};
+    float gate_{3.0f};
+    float birth_threshold_{0.0f};
+    std::size_t confirmation_{3};
+    std::size_t maximum_misses_{25};
+    std::size_t maximum_tracks_{0};
+    std::size_t next_id_{0};
+    std::size_t localizations_{0};
+    double timeout_{5.0};
+};
+
+constexpr float DirectionTracker::Pimpl::InitialVelocity;
+
+score::DirectionTracker::DirectionTracker() :
+    pimpl_(std::make_unique<Pimpl>()) {
+
+}
+
+score::DirectionTracker::~DirectionTracker() = default;
+
+void score::DirectionTracker::setLocalizer(const DirectionTracker::Localizer &localizer) {
+    pimpl_->localizer_ = localizer;
+}
+
+void score::DirectionTracker::setLocalizer(DOA &doa) {
+    pimpl_->localizer_ = [&doa](const AudioBufferView& input, std::vector<Observation>& observations) {
+        observations.push_back({doa.process(input), 1.0f});
+    };
+}
+
+void score::DirectionTracker::setLocalizer(SrpPhat &srp) {
+    pimpl_->localizer_ = [&srp](const AudioBufferView& input, std::vector<Observation>& observations) {
+        const auto direction = srp.process(input);
+        observations.push_back({direction.azimuth, direction.power});
+    };
+}
+
+void score::DirectionTracker::setLocalizer(Music &music) {
+    pimpl_->localizer_ = [&music](const AudioBufferView& input, std::vector<Observation>& observations) {
+        for (const auto& source : music.process(input)) {
+            observations.push_back({source.azimuth, source.power});
+        }
+    };
+}
+
+void score::DirectionTracker::setProcessNoise(float deviation) {
+    if (deviation < 0) {
+        throw std::invalid_argument("Expected a non-negative deviation.");
+    }
+    pimpl_->acceleration_ = deviation;
+}
+
+void score::DirectionTracker::setMeasurementNoise(float deviation) {
+    if (deviation <= 0) {
+        throw std::invalid_argument("Expected a positive deviation.");
+    }
+    pimpl_->measurement_ = deviation;
+}
+
+void score::DirectionTracker::setGate(float deviations) {
+    if (deviations <= 0) {
+        throw std::invalid_argument("Expected a positive gate.");
+    }
+    pimpl_->gate_ = deviations;
+}
+
+void score::DirectionTracker::setConfirmation(std::size_t hits) {
+    if (hits == 0) {
+        throw std::invalid_argument("Expected at least one hit.");
+    }
+    pimpl_->confirmation_ = hits;
+}
+
+void score::DirectionTracker::setTermination(std::size_t misses, double timeout) {
+    if (misses == 0 || timeout <= 0) {
+        throw std::invalid_argument("Expected a positive number of misses and timeout.");
+    }
+    pimpl_->maximum_misses_ = misses;
+    pimpl_->timeout_ = timeout;
+}
+
+void score::DirectionTracker::setMaximumTracks(std::size_t tracks) {
+    pimpl_->setMaximumTracks(tracks);
+}
+
+void score::DirectionTracker::setBirthThreshold(float power) {
+    pimpl_->birth_threshold_ = power;
+}
+
+const std::vector<DirectionTracker::Track> &score::DirectionTracker::process(const AudioBufferView &input) {
+    return pimpl_->process(input, input.type() != FrameType::Noise);
+}
+
+const std::vector<DirectionTracker::Track> &score::DirectionTracker::process(const AudioBufferView &input,
+        bool speech) {
+    return pimpl_->process(input, speech);
+}
+
+const std::vector<DirectionTracker::Track> &score::DirectionTracker::update(
+        const std::vector<Observation> &observations, double elapsed) {
+    return pimpl_->update(observations, elapsed);
+}
+
+const std::vector<DirectionTracker::Track> &score::DirectionTracker::predict(double elapsed) {
+    return pimpl_->predict(elapsed);
+}
+
+const std::vector<DirectionTracker::Track> &score::DirectionTracker::tracks() const {
+    return pimpl_->confirmed_;
+}
+
+std::size_t score::DirectionTracker::localizations() const {
+    return pimpl_->localizations_;
+}
+
+void score::DirectionTracker::reset() {
+    pimpl_->reset();
+}
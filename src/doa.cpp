@@ -1,28 +1,20 @@
 #include "doa.hpp"
-#include "utils.hpp"
 
-#include <edsp/spectral/dft.hpp>
-#include <complex>
 #include <algorithm>
-#include <tdoa.h>
+#include <cmath>
+#include <stdexcept>
 
 
 using namespace score;
 
-const auto abs_compare = [](const auto left, const auto right) {
-    return std::abs(left) < std::abs(right);
-};
-
 struct DOA::Pimpl {
 
-    explicit Pimpl(std::int32_t sample_rate, std::uint8_t num_microphones,
-            float microphone_distances, float sound_speed) :
-            num_microphones_(num_microphones),
-            maximum_tau_(microphone_distances / sound_speed),
+    explicit Pimpl(std::int32_t sample_rate, const ArrayGeometry& geometry, float sound_speed) :
+            geometry_(geometry),
             sample_rate_(sample_rate),
-            microphone_distances_(microphone_distances),
+            num_microphones_(static_cast<std::uint8_t>(geometry.size())),
             sound_speed_(sound_speed) {
-
+        rebuild();
     }
 
     ~Pimpl() {
@@ -33,64 +25,25 @@ struct DOA::Pimpl {
 
     }
 
-    // http://www.xavieranguera.com/phdthesis/node40.html
-    float gccPhat(const float* signal, const float* reference, size_t size) {
-        const auto expected_size = 2 * size;
-        if (expected_size != gcc_size_) {
-            gcc_size_ = (size_t) expected_size;
-
-            const auto nfft = edsp::spectral::make_fft_size(gcc_size_);
-            signal_.resize(expected_size, 0);
-            reference_.resize(expected_size, 0);
-            gcc_.resize(expected_size, 0);
-            signal_spectrum_.resize(nfft, 0);
-            reference_spectrum_.resize(nfft, 0);
-        }
-
-        std::copy(signal, signal + size, signal_.data());
-        std::copy(reference, reference + size, reference_.data());
-
-        edsp::spectral::dft(std::begin(signal_),
-                            std::end(signal_), std::begin(signal_spectrum_));
-        edsp::spectral::dft(std::begin(reference_),
-                            std::end(reference_), std::begin(reference_spectrum_));
-
-        std::transform(signal_spectrum_.begin(), signal_spectrum_.end(),
-                reference_spectrum_.begin(), signal_spectrum_.begin(), [](const auto& s, const auto& r) {
-            const auto operation = s * std::conj(r);
-            return operation / std::abs(operation);
-        });
-
-        edsp::spectral::idft(std::begin(signal_spectrum_), std::end(signal_spectrum_), std::begin(gcc_));
-
-        const auto maximum_tau_index = static_cast<std::size_t >(sample_rate_ * maximum_tau_);
-        const auto max_shift = std::min(expected_size / 2, maximum_tau_index);
-
-        const auto maximum_left = std::max_element(gcc_.begin(), gcc_.begin() + max_shift + 1, abs_compare);
-        const auto maximum_right = std::max_element(gcc_.end() - max_shift, gcc_.end(), abs_compare);
-
-        if (*maximum_left > *maximum_right) {
-            const auto shift = std::distance(gcc_.begin(), maximum_left) + max_shift;
-            return static_cast<float>(shift - max_shift) / sample_rate_;
-        } else {
-            const auto shift = std::distance(gcc_.end() - max_shift, maximum_right);
-            return static_cast<float>(shift - max_shift) / sample_rate_;
+    /**
+     * Precomputes, for every direction of the azimuth grid, the delays expected between the microphones of every
+     * group, and the maximum delay that can be found in every group.
+     */
+    void rebuild() {
+        const auto arrivals = geometry_.arrivalDelays(ArrayGeometry::AzimuthGrid(resolution_), {0.0f}, sound_speed_);
+        expected_.resize(arrivals.rows(), static_cast<Eigen::Index>(microphone_groups_.size()));
+        margins_.resize(microphone_groups_.size());
+        for (auto g = 0ul; g < microphone_groups_.size(); ++g) {
+            const auto& group = microphone_groups_[g];
+            const auto i = static_cast<Eigen::Index>(group.first);
+            const auto j = static_cast<Eigen::Index>(group.second);
+            expected_.col(static_cast<Eigen::Index>(g)) = arrivals.col(i) - arrivals.col(j);
+            margins_[g] = geometry_.maximumDelay(group.first, group.second, sample_rate_, sound_speed_);
         }
     }
 
-    float computeDOA() {
-        const auto min_index = std::distance(tau_.begin(), std::min_element(tau_.begin(), tau_.end(), abs_compare));
-        auto best_guess = 0;
-        if ((min_index != 0 and theta_[min_index - 1] >= 0) or (min_index == 0 and theta_.back() < 0)) {
-            best_guess = (theta_[min_index] + 360) % 360;
-        } else {
-            best_guess = (180 - theta_[min_index]);
-        }
-
-        return (best_guess + 120 + min_index * 60) % 360;
-    }
-
-    float process(const AudioBuffer& microphone_inputs) {
+    // http://www.xavieranguera.com/phdthesis/node40.html
+    const Vector<float>& estimateDelays(const AudioBufferView& microphone_inputs) {
         if (num_microphones_ != microphone_inputs.channels()) {
             throw std::runtime_error("Expected: " + std::to_string(num_microphones_) + " microphones");
         }
@@ -99,50 +52,103 @@ struct DOA::Pimpl {
             throw std::runtime_error("Empty group of microphones");
         }
 
+        const auto frames = microphone_inputs.framesPerChannel();
+        if (!gcc_ || gcc_->framesPerChannel() != frames) {
+            gcc_ = std::make_unique<GccPhat>(static_cast<std::int8_t>(num_microphones_), frames);
+            gcc_->setInterpolation(interpolation_);
+        }
+
+        // Every channel is transformed once, the pairs are computed from the cached spectra.
+        gcc_->analyze(microphone_inputs);
+        const auto maximum_margin = static_cast<std::int32_t>(frames - 1);
+        auto confidence = 0.0f;
         for (auto i = 0ul, size = tau_.size(); i < size; ++i) {
-            const auto group = microphone_groups_[i];
-            tau_[i] = gccPhat(microphone_inputs.channel(group.first),
-                    microphone_inputs.channel(group.second),
-                    microphone_inputs.framesPerChannel());
-            theta_[i] = static_cast<int>(std::asin(tau_[i] / maximum_tau_) * 180.0f / M_PI);
+            const auto& group = microphone_groups_[i];
+            const auto margin = std::min(maximum_margin, margins_[i]);
+            const auto peak = gcc_->correlate(group.first, group.second, margin);
+            tau_[i] = peak.delay / sample_rate_;
+            confidence += peak.value;
         }
+        confidence_ = confidence / static_cast<float>(tau_.size());
+        return tau_;
+    }
+
+    // The direction whose expected delays are closest, in the least-squares sense, to the estimated ones.
+    float computeDOA() {
+        const Eigen::Map<const Eigen::Matrix<float, 1, Eigen::Dynamic>> tau(tau_.data(),
+                                                                            static_cast<Eigen::Index>(tau_.size()));
+        Eigen::Index best = 0;
+        (expected_.rowwise() - tau).rowwise().squaredNorm().minCoeff(&best);
+        return 360.0f * static_cast<float>(best) / static_cast<float>(expected_.rows());
+    }
 
+    float process(const AudioBufferView& microphone_inputs) {
+        estimateDelays(microphone_inputs);
         return computeDOA();
     }
 
     void setGroupMicrophones(const std::vector<std::pair<std::size_t, std::size_t>>& microphone_groups) {
+        for (const auto& group : microphone_groups) {
+            if (group.first >= num_microphones_ || group.second >= num_microphones_) {
+                throw std::invalid_argument("Expected microphone indexes in the range [0, "
+                                            + std::to_string(num_microphones_) + ").");
+            }
+        }
         microphone_groups_ = microphone_groups;
         tau_.resize(microphone_groups.size());
-        theta_.resize(microphone_groups.size());
+        rebuild();
     }
 
-    std::vector<float> signal_{};
-    std::vector<float> reference_{};
-    std::vector<float> gcc_{};
+    ArrayGeometry geometry_;
+    std::unique_ptr<GccPhat> gcc_{nullptr};
+    GccPhat::Interpolation interpolation_{GccPhat::Parabolic};
     std::vector<float> tau_;
-    std::vector<int> theta_;
-    std::vector<std::complex<float>> signal_spectrum_{};
-    std::vector<std::complex<float>> reference_spectrum_{};
+    std::vector<std::int32_t> margins_;
+    Matrix<float> expected_;
     std::vector<std::pair<std::size_t, std::size_t>> microphone_groups_{};
-    std::size_t gcc_size_{0};
     std::int32_t sample_rate_{};
     std::uint8_t num_microphones_{};
-    float maximum_tau_{};
-    float microphone_distances_{};
+    float resolution_{1.0f};
+    float confidence_{0.0f};
     float sound_speed_{};
 };
 
 DOA::DOA(std::int32_t sample_rate, std::uint8_t num_microphones, float microphone_distances, float sound_speed) :
-    pimpl_(std::make_unique<Pimpl>(sample_rate, num_microphones, microphone_distances, sound_speed)){
+    DOA(sample_rate, ArrayGeometry::Circular(num_microphones, microphone_distances / 2), sound_speed) {
+
+}
+
+DOA::DOA(std::int32_t sample_rate, const ArrayGeometry &geometry, float sound_speed) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, geometry, sound_speed)) {
+
+}
+
+const ArrayGeometry &DOA::geometry() const {
+    return pimpl_->geometry_;
+}
 
+void DOA::setResolution(float degrees) {
+    if (degrees <= 0) {
+        throw std::invalid_argument("Expected a positive resolution.");
+    }
+    pimpl_->resolution_ = degrees;
+    pimpl_->rebuild();
 }
 
 void DOA::setGroupMicrophones(const std::vector<std::pair<std::size_t, std::size_t>>& microphone_groups) {
     pimpl_->setGroupMicrophones(microphone_groups);
 }
 
+void DOA::setInterpolation(GccPhat::Interpolation interpolation) {
+    pimpl_->interpolation_ = interpolation;
+    if (pimpl_->gcc_) {
+        pimpl_->gcc_->setInterpolation(interpolation);
+    }
+}
+
 void DOA::setSoundSpeed(float sound_speed) {
     pimpl_->sound_speed_ = sound_speed;
+    pimpl_->rebuild();
 }
 
 float DOA::soundSpeed() const {
@@ -153,12 +159,35 @@ const std::vector<std::pair<std::size_t, std::size_t>> &score::DOA::groupMicroph
     return pimpl_->microphone_groups_;
 }
 
-float DOA::process(const AudioBuffer &microphone_inputs) {
+const Vector<float> &DOA::estimateDelays(const AudioBufferView &microphone_inputs) {
+    return pimpl_->estimateDelays(microphone_inputs);
+}
+
+const Vector<float> &DOA::delays() const {
+    return pimpl_->tau_;
+}
+
+float DOA::confidence() const {
+    return pimpl_->confidence_;
+}
+
+std::vector<std::pair<std::size_t, std::size_t>> DOA::AllPairs(std::uint8_t num_microphones) {
+    std::vector<std::pair<std::size_t, std::size_t>> pairs;
+    for (auto i = 0ul; i < num_microphones; ++i) {
+        for (auto j = i + 1; j < num_microphones; ++j) {
+            pairs.emplace_back(i, j);
+        }
+    }
+    return pairs;
+}
+
+float DOA::process(const AudioBufferView &microphone_inputs) {
     return pimpl_->process(microphone_inputs);
 }
 
 void DOA::setSampleRate(std::int32_t sample_rate) {
     pimpl_->sample_rate_ = sample_rate;
+    pimpl_->rebuild();
 }
 
 float DOA::sampleRate() const {
@@ -13,14 +13,21 @@ struct DownMix::Pimpl {
 
 
 
-    void process(const AudioBuffer &input, AudioBuffer& output) {
+    void process(const AudioBufferView &input, AudioBuffer& output) {
         const auto channels = input.channels();
         const auto frame_length = input.framesPerChannel();
         output.setSampleRate(input.sampleRate());
         output.resize(1, frame_length);
         auto* out = output.channel(0);
+        std::fill(out, out + frame_length, 0.f);
         for (auto i = 0ul; i < channels; ++i) {
-            std::transform(out, out + frame_length, input.channel(i), out, std::plus<>());
+            if (input.isContiguous()) {
+                std::transform(out, out + frame_length, input.channel(i), out, std::plus<>());
+            } else {
+                for (auto j = 0ul; j < frame_length; ++j) {
+                    out[j] += input(i, j);
+                }
+            }
         }
 
         edsp::amplifier(out, out + frame_length, out, 1.f / static_cast<float>(channels));
@@ -31,7 +38,7 @@ struct DownMix::Pimpl {
     std::array<std::int16_t *, Bands::NumberBands> bands_ptr_{};
 };
 
-void score::DownMix::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::DownMix::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
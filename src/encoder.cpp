@@ -1,12 +1,23 @@
 #include "encoder.hpp"
+#include "ring_buffer.hpp"
 #include <sndfile.h>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 using namespace score;
 
 
 struct Encoder::Pimpl {
 
-    Pimpl(const std::string& file, std::int32_t sample_rate, std::int8_t channels) {
+    static constexpr auto DefaultSyncInterval = 1000;
+
+    Pimpl(const std::string& file, std::int32_t sample_rate, std::int8_t channels, Mode mode,
+            std::size_t queue_duration) :
+        mode_(mode) {
         info_.samplerate = sample_rate;
         info_.channels = channels;
         info_.format = SF_FORMAT_WAV | SF_FORMAT_PCM_16;
@@ -15,37 +26,176 @@ struct Encoder::Pimpl {
         if (file_ == nullptr) {
             throw std::runtime_error(sf_strerror(file_));
         }
+
+        // The synchronous mode keeps synchronizing after every write, batching only pays off with the queue.
+        setSyncInterval(mode_ == Mode::Asynchronous ? DefaultSyncInterval : 0);
+        if (mode_ == Mode::Asynchronous) {
+            const auto queue_frames = std::max<std::size_t>(1, queue_duration * sample_rate / 1000);
+            queue_ = std::make_unique<RingBuffer<float>>(queue_frames * channels);
+
+            // The writer wakes up several times per queue length and drains everything in large writes.
+            chunk_.resize(queue_->capacity() / 2);
+            write_interval_ = std::chrono::milliseconds(std::max<std::size_t>(1, queue_duration / 4));
+            running_ = true;
+            writer_ = std::thread(&Pimpl::run, this);
+        }
     }
 
     ~Pimpl() {
+        if (writer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(wake_mutex_);
+                running_ = false;
+            }
+            wake_.notify_one();
+            writer_.join();
+        }
+        sf_write_sync(file_);
         sf_close(file_);
     }
 
-    void process(const AudioBuffer& buffer) {
-        temporal_.resize(buffer.size());
-        buffer.toInterleave(temporal_.data());
+    void setSyncInterval(std::size_t milliseconds) {
+        sync_interval_ = milliseconds * static_cast<std::size_t>(info_.samplerate) / 1000;
+    }
 
-        const auto samples = sf_write_float(file_, temporal_.data(), temporal_.size());
-        if (samples != buffer.size()) {
-            throw std::runtime_error("Error while encoding buffer. Encoded samples: " + std::to_string(samples)
-            + "/" + std::to_string(buffer.size()));
+    std::size_t syncInterval() const {
+        return 1000 * sync_interval_ / static_cast<std::size_t>(info_.samplerate);
+    }
+
+    std::size_t write(const float* interleaved, std::size_t samples) {
+        const auto written = static_cast<std::size_t>(sf_write_float(file_, interleaved, samples));
+        pending_sync_ += written / info_.channels;
+        if (pending_sync_ >= sync_interval_.load(std::memory_order_relaxed)) {
+            sf_write_sync(file_);
+            pending_sync_ = 0;
+        }
+        return written;
+    }
+
+    // Drains the queue in chunks of complete frames.
+    void drain() {
+        std::lock_guard<std::mutex> lock(file_mutex_);
+        const auto frame = static_cast<std::size_t>(info_.channels);
+        while (true) {
+            const auto samples = std::min(queue_->available(), chunk_.size()) / frame * frame;
+            if (samples == 0) {
+                break;
+            }
+            queue_->read(chunk_.data(), samples);
+            const auto written = write(chunk_.data(), samples);
+            if (written != samples) {
+                dropped_.fetch_add((samples - written) / frame, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        while (running_) {
+            wake_.wait_for(lock, write_interval_, [this]() { return !running_ || flushing_; });
+            const auto flushing = flushing_;
+            lock.unlock();
+            drain();
+            lock.lock();
+            if (flushing) {
+                flushing_ = false;
+                drained_.notify_all();
+            }
+        }
+        lock.unlock();
+        drain();
+    }
+
+    void flush() {
+        if (mode_ == Mode::Asynchronous) {
+            // The writer drains everything queued before the request and signals it back.
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            flushing_ = true;
+            wake_.notify_one();
+            drained_.wait(lock, [this]() { return !flushing_; });
         }
+
+        std::lock_guard<std::mutex> lock(file_mutex_);
         sf_write_sync(file_);
+        pending_sync_ = 0;
+    }
+
+    void process(const AudioBufferView& buffer) {
+        if (buffer.channels() != info_.channels) {
+            throw std::invalid_argument("The encoder is configured to work with "
+                                        + std::to_string(info_.channels) + " channels.");
+        }
+
+        // Interleaved views, such as the ones wrapping the sound card buffers, are encoded without any copy.
+        const float* interleaved = buffer.channel(0);
+        if (!buffer.isInterleaved()) {
+            if (temporal_.size() != buffer.size()) {
+                temporal_.resize(buffer.size());
+            }
+            buffer.toInterleave(temporal_.data());
+            interleaved = temporal_.data();
+        }
+
+        if (mode_ == Mode::Asynchronous) {
+            if (!queue_->write(interleaved, buffer.size())) {
+                dropped_.fetch_add(buffer.framesPerChannel(), std::memory_order_relaxed);
+            }
+            return;
+        }
 
+        const auto written = write(interleaved, buffer.size());
+        if (written != buffer.size()) {
+            throw std::runtime_error("Error while encoding buffer. Encoded samples: " + std::to_string(written)
+            + "/" + std::to_string(buffer.size()));
+        }
     }
 
-private:
+    Mode mode_;
     std::vector<float> temporal_;
+    std::vector<float> chunk_;
+    std::atomic<std::size_t> sync_interval_{0};
+    std::size_t pending_sync_{0};
+    std::unique_ptr<RingBuffer<float>> queue_{};
+    std::atomic<std::size_t> dropped_{0};
+    std::chrono::milliseconds write_interval_{};
+    bool running_{false};
+    bool flushing_{false};
+    std::thread writer_{};
+    std::mutex wake_mutex_{};
+    std::mutex file_mutex_{};
+    std::condition_variable wake_{};
+    std::condition_variable drained_{};
     SF_INFO info_{};
     SNDFILE* file_;
 };
 
-score::Encoder::Encoder(const std::string &file, std::int32_t sample_rate, std::int8_t channels) :
-    pimpl_(std::make_unique<Pimpl>(file, sample_rate, channels)) {
+score::Encoder::Encoder(const std::string &file, std::int32_t sample_rate, std::int8_t channels, Mode mode,
+        std::size_t queue_duration) :
+    pimpl_(std::make_unique<Pimpl>(file, sample_rate, channels, mode, queue_duration)) {
 }
 
-void score::Encoder::process(const AudioBuffer &input) {
+void score::Encoder::process(const AudioBufferView &input) {
     pimpl_->process(input);
 }
 
+Encoder::Mode score::Encoder::mode() const {
+    return pimpl_->mode_;
+}
+
+void score::Encoder::setSyncInterval(std::size_t milliseconds) {
+    pimpl_->setSyncInterval(milliseconds);
+}
+
+std::size_t score::Encoder::syncInterval() const {
+    return pimpl_->syncInterval();
+}
+
+std::size_t score::Encoder::droppedFrames() const {
+    return pimpl_->dropped_.load(std::memory_order_relaxed);
+}
+
+void score::Encoder::flush() {
+    pimpl_->flush();
+}
+
 score::Encoder::~Encoder() = default;
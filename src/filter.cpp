@@ -10,6 +10,9 @@ using InverseChebyshevDesigner = edsp::filter::designer<float, edsp::filter::des
 struct Filter::Pimpl {
     static constexpr auto MaximumOrder = 100;
 
+    // Cost in nanoseconds per sample and order of the filter, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSampleAndOrder = 1ul;
+
     Pimpl(std::int32_t sample_rate, std::int8_t channels) :
             sample_rate_(sample_rate), cascades_(channels) {
         
@@ -122,7 +125,11 @@ struct Filter::Pimpl {
         need_update_ = true;
     }
     
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != cascades_.size()) {
             throw std::invalid_argument("Expected an input frame with "
                                         + std::to_string(cascades_.size()) + " channels.");
@@ -138,10 +145,17 @@ struct Filter::Pimpl {
 
         output.setSampleRate(input.sampleRate());
         output.resize(input.channels(), input.framesPerChannel());
-        for (auto i = 0ul; i < input.channels(); ++i) {
+        const auto process_channel = [&](std::size_t i) {
             cascades_[i].filter(input.channel(i), input.channel(i) + input.framesPerChannel(), output.channel(i));
-        }
+        };
 
+        if (pool_ && ThreadPool::isWorthDispatching(input.size() * order_ * CostPerSampleAndOrder)) {
+            pool_->parallelFor(input.channels(), process_channel);
+        } else {
+            for (auto i = 0ul; i < input.channels(); ++i) {
+                process_channel(i);
+            }
+        }
     }
 
     float cut_off_{500};
@@ -155,6 +169,7 @@ struct Filter::Pimpl {
     DesignerType designer_type_{Filter::DesignerType::Butterworth};
     std::size_t order_{4};
     std::vector<edsp::filter::biquad_cascade<float, MaximumOrder>> cascades_{};
+    std::shared_ptr<ThreadPool> pool_{nullptr};
 };
 
 Filter::DesignerType score::Filter::designer() const {
@@ -228,7 +243,7 @@ float score::Filter::bandwidth() const {
     return pimpl_->bandwidth_;
 }
 
-void score::Filter::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::Filter::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
@@ -241,4 +256,8 @@ void score::Filter::reset() {
     pimpl_->reset();
 }
 
+void score::Filter::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
 score::Filter::~Filter() = default;
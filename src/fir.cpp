@@ -14,7 +14,11 @@ struct FIR::Pimpl {
 
     }
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != firs_.size()) {
             throw std::invalid_argument("Expected an input frame with "
                                         + std::to_string(firs_.size()) + " channels.");
@@ -50,6 +54,6 @@ std::size_t score::FIR::order() const {
     return pimpl_->coefficients_.size();
 }
 
-void score::FIR::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::FIR::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
@@ -0,0 +1,95 @@
+#include "frame_adapter.hpp"
+
+using namespace score;
+
+struct FrameAdapter::Pimpl {
+
+    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel) :
+        sample_rate_(sample_rate),
+        channels_(channels),
+        frame_(sample_rate, channels, frames_per_channel) {
+        if (frames_per_channel == 0) {
+            throw std::invalid_argument("Expected a frame of at least one sample per channel.");
+        }
+    }
+
+    void process(const AudioBufferView& input) {
+        if (input.channels() != channels_) {
+            throw std::invalid_argument("The adapter is configured to work with "
+                                        + std::to_string(channels_) + " channels.");
+        }
+
+        if (input.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Expected an input frame at " + std::to_string(sample_rate_) + " Hz.");
+        }
+
+        const auto length = frame_.framesPerChannel();
+        const auto available = input.framesPerChannel();
+        for (auto offset = 0ul; offset < available;) {
+            if (pending_ == 0) {
+                frame_.setTimestamp(input.timestamp() + static_cast<double>(offset) / sample_rate_);
+                frame_.setType(input.type());
+            }
+
+            const auto copied = std::min(length - pending_, available - offset);
+            for (auto i = 0ul; i < channels_; ++i) {
+                auto* out = frame_.channel(i) + pending_;
+                if (input.isContiguous()) {
+                    std::copy(input.channel(i) + offset, input.channel(i) + offset + copied, out);
+                } else {
+                    for (auto j = 0ul; j < copied; ++j) {
+                        out[j] = input(i, offset + j);
+                    }
+                }
+            }
+
+            offset += copied;
+            pending_ += copied;
+            if (pending_ == length) {
+                pending_ = 0;
+                if (on_frame_ready_) {
+                    on_frame_ready_(frame_);
+                }
+            }
+        }
+    }
+
+    std::int32_t sample_rate_;
+    std::int8_t channels_;
+    std::size_t pending_{0};
+    AudioBuffer frame_;
+    std::function<void(AudioBuffer& frame)> on_frame_ready_{nullptr};
+};
+
+score::FrameAdapter::FrameAdapter(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, frames_per_channel)) {
+
+}
+
+std::unique_ptr<FrameAdapter> score::FrameAdapter::FromDuration(std::int32_t sample_rate, std::int8_t channels,
+        std::size_t duration) {
+    const auto frames = static_cast<std::size_t>(static_cast<std::int64_t>(sample_rate) * duration / 1000);
+    return std::make_unique<FrameAdapter>(sample_rate, channels, frames);
+}
+
+score::FrameAdapter::~FrameAdapter() = default;
+
+void score::FrameAdapter::setOnFrameReady(const std::function<void(AudioBuffer& frame)> &callback) {
+    pimpl_->on_frame_ready_ = callback;
+}
+
+void score::FrameAdapter::process(const AudioBufferView &input) {
+    pimpl_->process(input);
+}
+
+void score::FrameAdapter::reset() {
+    pimpl_->pending_ = 0;
+}
+
+std::size_t score::FrameAdapter::framesPerChannel() const {
+    return pimpl_->frame_.framesPerChannel();
+}
+
+std::size_t score::FrameAdapter::pending() const {
+    return pimpl_->pending_;
+}
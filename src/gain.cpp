@@ -19,7 +19,7 @@ struct Gain::Pimpl {
     }
 
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
 
         // Do not modify the signal.
         if (last_gain_ == current_gain_ && gainCloseToOne(current_gain_)) {
@@ -31,11 +31,18 @@ struct Gain::Pimpl {
         output.resize(input.channels(), input.framesPerChannel());
 
         // Gain is constant and different from 1.
+        const auto stride = input.stride();
         if (last_gain_ == current_gain_) {
             for (auto ch = 0ul; ch < input.channels(); ++ch) {
                 auto* out = output.channel(ch);
                 auto* in = input.channel(ch);
-                edsp::amplifier(in, in + input.framesPerChannel(), out, current_gain_);
+                if (input.isContiguous()) {
+                    edsp::amplifier(in, in + input.framesPerChannel(), out, current_gain_);
+                } else {
+                    for (auto i = 0ul; i < input.framesPerChannel(); ++i) {
+                        out[i] = in[i * stride] * current_gain_;
+                    }
+                }
             }
             return;
         }
@@ -48,7 +55,7 @@ struct Gain::Pimpl {
             auto* in = input.channel(ch);
             float gain = last_gain_;
             for (auto i = 0ul; i < input.framesPerChannel(); ++i) {
-                out[i] = in[i] * gain;
+                out[i] = in[i * stride] * gain;
                 gain += increment;
             }
         }
@@ -74,7 +81,7 @@ score::Gain::Gain(float gain):
 
 }
 
-void score::Gain::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::Gain::process(const AudioBufferView &input, AudioBuffer &output) {
     return pimpl_->process(input, output);
 }
 
@@ -0,0 +1,207 @@
+#include "gcc_phat.hpp"
+#include "real_fft.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    std::size_t upperPowerOfTwo(std::size_t value) {
+        std::size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+}
+
+struct GccPhat::Pimpl {
+
+    Pimpl(std::int8_t channels, std::size_t frames_per_channel) :
+        channels_(channels),
+        frames_per_channel_(frames_per_channel),
+        fft_size_(upperPowerOfTwo(2 * frames_per_channel)),
+        bins_(fft_size_ / 2 + 1) {
+
+        if (channels_ <= 0 || frames_per_channel_ == 0) {
+            throw std::invalid_argument("Expected at least one channel and one sample per channel.");
+        }
+
+        // Lanczos kernel interpolating the correlation at every fraction of the grid.
+        for (auto j = 0; j < Factor; ++j) {
+            for (auto t = 1 - Taps; t <= Taps; ++t) {
+                const auto x = t - static_cast<double>(j) / Factor;
+                const auto value = std::abs(x) < 1e-9 ? 1.0 : Taps * std::sin(M_PI * x) * std::sin(M_PI * x / Taps)
+                                                              / (M_PI * M_PI * x * x);
+                kernel_[static_cast<std::size_t>(j * 2 * Taps + t + Taps - 1)] = static_cast<float>(value);
+            }
+        }
+
+        fft_ = std::make_unique<RealFFT>(fft_size_);
+        frame_.assign(fft_size_, 0.0f);
+        correlation_.assign(fft_size_, 0.0f);
+        cross_.resize(bins_);
+        spectra_.resize(channels_, static_cast<Eigen::Index>(bins_));
+    }
+
+    void analyze(const AudioBufferView& input) {
+        if (input.channels() != channels_ || input.framesPerChannel() != frames_per_channel_) {
+            throw std::invalid_argument("Expected a frame with " + std::to_string(channels_) + " channels and "
+                                        + std::to_string(frames_per_channel_) + " samples per channel.");
+        }
+
+        // The tail of the frame is never written, so the zero padding is kept between calls.
+        for (auto i = 0; i < channels_; ++i) {
+            for (auto j = 0ul; j < frames_per_channel_; ++j) {
+                frame_[j] = input(i, j);
+            }
+            fft_->forward(frame_.data(), spectra_.row(i).data());
+        }
+    }
+
+    Peak correlate(std::size_t channel, std::size_t reference, std::int32_t margin) {
+        if (channel >= static_cast<std::size_t>(channels_) || reference >= static_cast<std::size_t>(channels_)) {
+            throw std::invalid_argument("Expected channels in the range [0, " + std::to_string(channels_) + ").");
+        }
+
+        if (margin < 0 || static_cast<std::size_t>(margin) >= frames_per_channel_) {
+            throw std::invalid_argument("Expected a margin in the range [0, "
+                                        + std::to_string(frames_per_channel_) + ").");
+        }
+
+        // Cross spectrum X(k) * conj(R(k)) weighted by the inverse of its magnitude.
+        const auto* x = spectra_.row(static_cast<Eigen::Index>(channel)).data();
+        const auto* r = spectra_.row(static_cast<Eigen::Index>(reference)).data();
+        for (auto k = 0ul; k < bins_; ++k) {
+            const auto product = x[k] * std::conj(r[k]);
+            const auto magnitude = std::abs(product);
+            const auto weight = magnitude > Epsilon ? 1.0f / (magnitude * fft_size_) : 0.0f;
+            cross_[k] = product * weight;
+        }
+        fft_->inverse(cross_.data(), correlation_.data());
+
+        Peak peak{0, correlation_[0], 0};
+        for (auto lag = -margin; lag <= margin; ++lag) {
+            const auto value = at(lag);
+            if (value > peak.value) {
+                peak = Peak{lag, value, static_cast<float>(lag)};
+            }
+        }
+
+        switch (interpolation_) {
+            case Interpolation::None:
+                break;
+            case Interpolation::Parabolic:
+                peak.delay = peak.lag + parabolic(at(peak.lag - 1), peak.value, at(peak.lag + 1));
+                break;
+            case Interpolation::BandLimited:
+                peak.delay = bandLimited(peak.lag);
+                break;
+        }
+        return peak;
+    }
+
+    float at(std::int32_t lag) const {
+        return correlation_[static_cast<std::size_t>(lag + static_cast<std::int32_t>(fft_size_)) % fft_size_];
+    }
+
+    // Offset of the vertex of the parabola through three equally spaced points, centered in the middle one.
+    static float parabolic(float left, float center, float right) {
+        const auto curvature = left - 2 * center + right;
+        if (curvature >= 0) {
+            return 0;
+        }
+        return std::max(-0.5f, std::min(0.5f, 0.5f * (left - right) / curvature));
+    }
+
+    // Correlation at the given point of the grid, interpolated from the neighbouring lags.
+    float evaluate(std::int32_t position) const {
+        const auto lag = position >= 0 ? position / Factor : -((Factor - 1 - position) / Factor);
+        const auto* kernel = kernel_.data() + (position - lag * Factor) * 2 * Taps;
+        auto sum = 0.0f;
+        for (auto t = 1 - Taps; t <= Taps; ++t) {
+            sum += kernel[t + Taps - 1] * at(lag + t);
+        }
+        return sum;
+    }
+
+    // Upsamples the correlation within one sample of the integer maximum and fits a parabola on the best point of
+    // the dense grid. Only the window around the maximum is interpolated, so the cost does not depend on the FFT.
+    float bandLimited(std::int32_t lag) const {
+        auto best = lag * Factor;
+        auto best_value = evaluate(best);
+        for (auto position = (lag - 1) * Factor; position <= (lag + 1) * Factor; ++position) {
+            const auto value = evaluate(position);
+            if (value > best_value) {
+                best = position;
+                best_value = value;
+            }
+        }
+
+        const auto offset = parabolic(evaluate(best - 1), best_value, evaluate(best + 1));
+        return (static_cast<float>(best) + offset) / Factor;
+    }
+
+    static constexpr auto Factor = 8;
+    static constexpr auto Taps = 8;
+
+    static constexpr float Epsilon = 1e-20f;
+
+    Interpolation interpolation_{Interpolation::None};
+    std::int8_t channels_;
+    std::size_t frames_per_channel_;
+    std::size_t fft_size_;
+    std::size_t bins_;
+    std::unique_ptr<RealFFT> fft_{nullptr};
+    std::vector<float> frame_{};
+    std::vector<float> correlation_{};
+    std::vector<std::complex<float>> cross_{};
+    std::array<float, Factor * 2 * Taps> kernel_{};
+    Matrix<std::complex<float>> spectra_{};
+};
+
+constexpr float GccPhat::Pimpl::Epsilon;
+
+score::GccPhat::GccPhat(std::int8_t channels, std::size_t frames_per_channel) :
+    pimpl_(std::make_unique<Pimpl>(channels, frames_per_channel)) {
+
+}
+
+score::GccPhat::~GccPhat() = default;
+
+std::int8_t score::GccPhat::channels() const {
+    return pimpl_->channels_;
+}
+
+std::size_t score::GccPhat::framesPerChannel() const {
+    return pimpl_->frames_per_channel_;
+}
+
+std::size_t score::GccPhat::fftSize() const {
+    return pimpl_->fft_size_;
+}
+
+GccPhat::Interpolation score::GccPhat::interpolation() const {
+    return pimpl_->interpolation_;
+}
+
+void score::GccPhat::setInterpolation(GccPhat::Interpolation interpolation) {
+    pimpl_->interpolation_ = interpolation;
+}
+
+void score::GccPhat::analyze(const AudioBufferView &input) {
+    pimpl_->analyze(input);
+}
+
+GccPhat::Peak score::GccPhat::correlate(std::size_t channel, std::size_t reference, std::int32_t margin) {
+    return pimpl_->correlate(channel, reference, margin);
+}
+
+const float *score::GccPhat::correlation() const {
+    return pimpl_->correlation_.data();
+}
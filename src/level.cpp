@@ -12,7 +12,11 @@ struct LevelEstimator::Pimpl {
 
     }
 
-    const Vector<float> & process(const score::AudioBuffer &input) {
+    const Vector<float> & process(const score::AudioBufferView &input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != levels_.size()) {
             throw std::invalid_argument("Expected an input frame with "
                                         + std::to_string(levels_.size()) + " channels.");
@@ -38,7 +42,7 @@ score::LevelEstimator::LevelEstimator(std::int8_t channels) :
 
 score::LevelEstimator::~LevelEstimator() = default;
 
-const Vector<float> & score::LevelEstimator::process(const score::AudioBuffer &input) {
+const Vector<float> & score::LevelEstimator::process(const score::AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
@@ -6,6 +6,9 @@ using namespace score;
 
 struct LowCutFilter::Pimpl {
 
+    // Cost in nanoseconds per sample, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSample = 3ul;
+
     Pimpl(std::int32_t sample_rate, std::int8_t channels) :
         sample_rate_(sample_rate),
         channels_(channels),
@@ -13,7 +16,11 @@ struct LowCutFilter::Pimpl {
 
     }
 
-    void process(const score::AudioBuffer &input, score::AudioBuffer &output) {
+    void process(const score::AudioBufferView &input, score::AudioBuffer &output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
@@ -27,10 +34,21 @@ struct LowCutFilter::Pimpl {
 
         output.setSampleRate(input.sampleRate());
         output.resize(input.channels(), input.framesPerChannel());
-        for (auto i = 0ul; i < channels_; ++i) {
+        const auto process_channel = [&](std::size_t i) {
             filters_[i].filter(input.channel(i), input.channel(i) + input.framesPerChannel(), output.channel(i));
+        };
+
+        if (pool_ && ThreadPool::isWorthDispatching(input.size() * CostPerSample)) {
+            pool_->parallelFor(channels_, process_channel);
+        } else {
+            for (auto i = 0ul; i < channels_; ++i) {
+                process_channel(i);
+            }
         }
     }
+
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+
 private:
     std::int8_t channels_;
     std::int32_t sample_rate_;
@@ -43,8 +61,12 @@ score::LowCutFilter::LowCutFilter(std::int32_t sample_rate, std::int8_t channels
 
 }
 
-void score::LowCutFilter::process(const score::AudioBuffer &input, score::AudioBuffer &output) {
+void score::LowCutFilter::process(const score::AudioBufferView &input, score::AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
+void score::LowCutFilter::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
 score::LowCutFilter::~LowCutFilter() = default;
@@ -0,0 +1,351 @@
+#include "music.hpp"
+#include "real_fft.hpp"
+
+#include <eigen3/Eigen/Eigenvalues>
+#include <eigen3/Eigen/StdVector>
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    using Complex = std::complex<float>;
+
+    std::size_t upperPowerOfTwo(std::size_t value) {
+        std::size_t power = 1;
+        while (power < value) {
+            power <<= 1;
+        }
+        return power;
+    }
+
+    /**
+     * Recursive spatial covariance matrices of a band of frequency bins and the projectors over their noise
+     * subspaces. The spectra are given as a [channels x bins] matrix.
+     */
+    struct Subspaces {
+        virtual ~Subspaces() = default;
+        virtual void update(const Matrix<Complex>& spectra, std::size_t first, float factor) = 0;
+        virtual float drift() const = 0;
+        virtual void decompose(std::size_t sources) = 0;
+        virtual float projection(std::size_t bin, const Complex* steering) const = 0;
+        virtual void reset() = 0;
+    };
+
+    template <int Channels>
+    struct FixedSubspaces : public Subspaces {
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        using Square = Eigen::Matrix<Complex, Channels, Channels>;
+        using Column = Eigen::Matrix<Complex, Channels, 1>;
+        using Squares = std::vector<Square, Eigen::aligned_allocator<Square>>;
+
+        FixedSubspaces(std::size_t channels, std::size_t bins) :
+            channels_(static_cast<Eigen::Index>(channels)),
+            covariance_(bins, Square::Zero(channels_, channels_)),
+            decomposed_(bins, Square::Zero(channels_, channels_)),
+            projector_(bins, Square::Identity(channels_, channels_)),
+            solver_(channels_) {
+
+        }
+
+        void update(const Matrix<Complex>& spectra, std::size_t first, float factor) override {
+            for (auto b = 0ul; b < covariance_.size(); ++b) {
+                const auto x = spectra.col(static_cast<Eigen::Index>(first + b));
+                auto& covariance = covariance_[b];
+                covariance *= factor;
+                covariance.noalias() += (1 - factor) * x * x.adjoint();
+            }
+        }
+
+        float drift() const override {
+            auto difference = 0.0f;
+            auto norm = 0.0f;
+            for (auto b = 0ul; b < covariance_.size(); ++b) {
+                difference += (covariance_[b] - decomposed_[b]).squaredNorm();
+                norm += decomposed_[b].squaredNorm();
+            }
+            return norm > 0 ? std::sqrt(difference / norm) : std::numeric_limits<float>::max();
+        }
+
+        void decompose(std::size_t sources) override {
+            const auto noise = channels_ - static_cast<Eigen::Index>(sources);
+            for (auto b = 0ul; b < covariance_.size(); ++b) {
+                // The eigenvalues are sorted in increasing order: the first ones span the noise subspace.
+                solver_.compute(covariance_[b]);
+                const auto& vectors = solver_.eigenvectors();
+                projector_[b].noalias() = vectors.leftCols(noise) * vectors.leftCols(noise).adjoint();
+                decomposed_[b] = covariance_[b];
+            }
+        }
+
+        float projection(std::size_t bin, const Complex* steering) const override {
+            const Eigen::Map<const Column> a(steering, channels_);
+            return std::max(std::real((a.adjoint() * projector_[bin] * a)(0, 0)), 0.0f);
+        }
+
+        void reset() override {
+            for (auto b = 0ul; b < covariance_.size(); ++b) {
+                covariance_[b].setZero();
+                decomposed_[b].setZero();
+                projector_[b].setIdentity();
+            }
+        }
+
+        Eigen::Index channels_;
+        Squares covariance_;
+        Squares decomposed_;
+        Squares projector_;
+        Eigen::SelfAdjointEigenSolver<Square> solver_;
+    };
+
+    std::unique_ptr<Subspaces> makeSubspaces(std::size_t channels, std::size_t bins) {
+        switch (channels) {
+            case 2:
+                return std::make_unique<FixedSubspaces<2>>(channels, bins);
+            case 4:
+                return std::make_unique<FixedSubspaces<4>>(channels, bins);
+            case 6:
+                return std::make_unique<FixedSubspaces<6>>(channels, bins);
+            case 8:
+                return std::make_unique<FixedSubspaces<8>>(channels, bins);
+            default:
+                return std::make_unique<FixedSubspaces<Eigen::Dynamic>>(channels, bins);
+        }
+    }
+
+}
+
+struct Music::Pimpl {
+
+    Pimpl(std::int32_t sample_rate, std::size_t frames_per_channel, const ArrayGeometry& microphones,
+          float sound_speed) :
+        sample_rate_(sample_rate),
+        frames_per_channel_(frames_per_channel),
+        sound_speed_(sound_speed),
+        microphones_(microphones),
+        fft_(upperPowerOfTwo(frames_per_channel)) {
+
+        if (microphones_.size() < 2 || microphones_.size() > AudioBufferView::MaximumChannels) {
+            throw std::invalid_argument("Expected between 2 and " + std::to_string(AudioBufferView::MaximumChannels)
+                                        + " microphones.");
+        }
+
+        // Periodic Hann window, the frame is zero-padded up to the size of the FFT.
+        window_.resize(frames_per_channel_);
+        for (auto i = 0ul; i < frames_per_channel_; ++i) {
+            window_[i] = 0.5f - 0.5f * std::cos(2 * static_cast<float>(M_PI) * i / frames_per_channel_);
+        }
+        frame_.assign(fft_.size(), 0.0f);
+        spectra_.resize(static_cast<Eigen::Index>(microphones_.size()), static_cast<Eigen::Index>(fft_.bins()));
+        steering_.resize(microphones_.size());
+        rotation_.resize(microphones_.size());
+        sources_.reserve(microphones_.size());
+
+        setFrequencyRange(minimum_frequency_, maximum_frequency_);
+        setResolution(resolution_);
+    }
+
+    void setFrequencyRange(float minimum, float maximum) {
+        const auto resolution = static_cast<float>(sample_rate_) / fft_.size();
+        const auto first = static_cast<std::size_t>(std::max(1.0f, std::ceil(minimum / resolution)));
+        const auto last = std::min(fft_.bins() - 1, static_cast<std::size_t>(std::floor(maximum / resolution)));
+        if (minimum < 0 || first > last) {
+            throw std::invalid_argument("Expected a band containing at least one frequency bin.");
+        }
+
+        minimum_frequency_ = minimum;
+        maximum_frequency_ = maximum;
+        first_bin_ = first;
+        band_ = last - first + 1;
+        subspaces_ = makeSubspaces(microphones_.size(), band_);
+        decomposed_ = false;
+    }
+
+    void setResolution(float degrees) {
+        if (degrees <= 0) {
+            throw std::invalid_argument("Expected a positive resolution.");
+        }
+
+        resolution_ = degrees;
+        // Time of arrival at every microphone with respect to the origin of the array.
+        delays_ = microphones_.arrivalDelays(ArrayGeometry::AzimuthGrid(degrees), {0.0f}, sound_speed_);
+        const auto directions = static_cast<std::size_t>(delays_.rows());
+        spectrum_.assign(directions, 0.0f);
+        peaks_.clear();
+        peaks_.reserve(directions);
+        decomposed_ = false;
+    }
+
+    void evaluate() {
+        const auto step = 2 * M_PI * sample_rate_ / fft_.size();
+        for (auto d = 0ul; d < spectrum_.size(); ++d) {
+            // Steering vectors exp(-j w tau) of consecutive bins, computed with one rotation per microphone.
+            for (auto m = 0ul; m < microphones_.size(); ++m) {
+                const auto delay = static_cast<double>(delays_(d, m));
+                steering_[m] = std::polar(1.0f, static_cast<float>(-step * first_bin_ * delay));
+                rotation_[m] = std::polar(1.0f, static_cast<float>(-step * delay));
+            }
+
+            auto denominator = 0.0f;
+            for (auto b = 0ul; b < band_; ++b) {
+                denominator += subspaces_->projection(b, steering_.data());
+                for (auto m = 0ul; m < microphones_.size(); ++m) {
+                    steering_[m] *= rotation_[m];
+                }
+            }
+            spectrum_[d] = band_ / std::max(denominator, std::numeric_limits<float>::min());
+        }
+    }
+
+    void peaks(std::size_t sources) {
+        const auto directions = spectrum_.size();
+        peaks_.clear();
+        for (auto d = 0ul; d < directions; ++d) {
+            const auto previous = spectrum_[(d + directions - 1) % directions];
+            const auto next = spectrum_[(d + 1) % directions];
+            if (spectrum_[d] > previous && spectrum_[d] >= next) {
+                peaks_.push_back(d);
+            }
+        }
+
+        const auto count = std::min(sources, peaks_.size());
+        std::partial_sort(peaks_.begin(), peaks_.begin() + count, peaks_.end(), [this](auto left, auto right) {
+            return spectrum_[left] > spectrum_[right];
+        });
+
+        sources_.clear();
+        for (auto i = 0ul; i < count; ++i) {
+            sources_.push_back(Source{360.0f * peaks_[i] / directions, spectrum_[peaks_[i]]});
+        }
+    }
+
+    const std::vector<Source>& process(const AudioBufferView& input) {
+        if (input.sampleRate() != sample_rate_ || input.framesPerChannel() != frames_per_channel_
+            || static_cast<std::size_t>(input.channels()) != microphones_.size()) {
+            throw std::invalid_argument("Expected a frame of " + std::to_string(sample_rate_) + " Hz with "
+                                        + std::to_string(microphones_.size()) + " channels and "
+                                        + std::to_string(frames_per_channel_) + " samples per channel.");
+        }
+
+        for (auto m = 0; m < input.channels(); ++m) {
+            for (auto i = 0ul; i < frames_per_channel_; ++i) {
+                frame_[i] = window_[i] * input(m, i);
+            }
+            fft_.forward(frame_.data(), spectra_.row(m).data());
+        }
+
+        subspaces_->update(spectra_, first_bin_, forgetting_factor_);
+        ++frames_since_decomposition_;
+        if (!decomposed_ || frames_since_decomposition_ >= update_interval_
+            || subspaces_->drift() > drift_threshold_) {
+            subspaces_->decompose(sources_count_);
+            evaluate();
+            peaks(sources_count_);
+            frames_since_decomposition_ = 0;
+            decomposed_ = true;
+            ++decompositions_;
+        }
+        return sources_;
+    }
+
+    void reset() {
+        subspaces_->reset();
+        std::fill(spectrum_.begin(), spectrum_.end(), 0.0f);
+        sources_.clear();
+        frames_since_decomposition_ = 0;
+        decomposed_ = false;
+    }
+
+    std::int32_t sample_rate_;
+    std::size_t frames_per_channel_;
+    float sound_speed_;
+    ArrayGeometry microphones_;
+    RealFFT fft_;
+    std::size_t sources_count_{1};
+    float forgetting_factor_{0.95f};
+    float minimum_frequency_{300.0f};
+    float maximum_frequency_{4000.0f};
+    float drift_threshold_{0.2f};
+    float resolution_{1.0f};
+    std::size_t update_interval_{10};
+    std::size_t first_bin_{1};
+    std::size_t band_{0};
+    std::size_t frames_since_decomposition_{0};
+    std::size_t decompositions_{0};
+    bool decomposed_{false};
+    std::vector<float> window_{};
+    std::vector<float> frame_{};
+    Matrix<Complex> spectra_{};
+    Matrix<float> delays_{};
+    std::vector<Complex> steering_{};
+    std::vector<Complex> rotation_{};
+    std::unique_ptr<Subspaces> subspaces_{nullptr};
+    Vector<float> spectrum_{};
+    std::vector<std::size_t> peaks_{};
+    std::vector<Source> sources_{};
+};
+
+score::Music::Music(std::int32_t sample_rate, std::size_t frames_per_channel,
+        const ArrayGeometry &microphones, float sound_speed) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, frames_per_channel, microphones, sound_speed)) {
+
+}
+
+score::Music::~Music() = default;
+
+std::size_t score::Music::sources() const {
+    return pimpl_->sources_count_;
+}
+
+void score::Music::setSources(std::size_t sources) {
+    if (sources == 0 || sources >= pimpl_->microphones_.size()) {
+        throw std::invalid_argument("Expected between 1 and " + std::to_string(pimpl_->microphones_.size() - 1)
+                                    + " sources.");
+    }
+    pimpl_->sources_count_ = sources;
+    pimpl_->decomposed_ = false;
+}
+
+void score::Music::setForgettingFactor(float factor) {
+    if (factor <= 0 || factor >= 1) {
+        throw std::invalid_argument("Expected a forgetting factor in the range (0, 1).");
+    }
+    pimpl_->forgetting_factor_ = factor;
+}
+
+void score::Music::setFrequencyRange(float minimum, float maximum) {
+    pimpl_->setFrequencyRange(minimum, maximum);
+}
+
+void score::Music::setUpdateInterval(std::size_t frames) {
+    pimpl_->update_interval_ = std::max<std::size_t>(1, frames);
+}
+
+void score::Music::setDriftThreshold(float threshold) {
+    pimpl_->drift_threshold_ = threshold;
+}
+
+void score::Music::setResolution(float degrees) {
+    pimpl_->setResolution(degrees);
+}
+
+std::size_t score::Music::decompositions() const {
+    return pimpl_->decompositions_;
+}
+
+const Vector<float> &score::Music::spectrum() const {
+    return pimpl_->spectrum_;
+}
+
+const std::vector<Music::Source> &score::Music::process(const AudioBufferView &input) {
+    return pimpl_->process(input);
+}
+
+void score::Music::reset() {
+    pimpl_->reset();
+}
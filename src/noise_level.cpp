@@ -16,7 +16,7 @@ struct NoiseLevel::Pimpl {
         min_noise_energy_ = static_cast<float>(sample_rate) * 2.f * 2.f / number_frames_per_second;
     }
 
-    float computeEnergy(const AudioBuffer& input) {
+    float computeEnergy(const AudioBufferView& input) {
         auto energy = 0.0f;
         for (auto i = 0; i < input.channels(); ++i) {
             energy = std::max(energy,
@@ -35,7 +35,11 @@ struct NoiseLevel::Pimpl {
     }
 
 
-    float process(const AudioBuffer& input) {
+    float process(const AudioBufferView& input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Expected an input frame at " + std::to_string(sample_rate_) + " Hz.");
@@ -92,7 +96,7 @@ score::NoiseLevel::NoiseLevel(std::int32_t sample_rate, std::size_t frame_length
 
 }
 
-float score::NoiseLevel::process(const AudioBuffer &input) {
+float score::NoiseLevel::process(const AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
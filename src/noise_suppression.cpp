@@ -37,6 +37,9 @@ struct NoiseSuppression::Pimpl {
     static constexpr auto ExpectedDuration = 10;
     static constexpr auto MaximumAllowedSize = 160;
 
+    // Cost in nanoseconds per sample, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSample = 100ul;
+
     Pimpl(std::int32_t sample_rate, std::int8_t channels, Policy policy) :
         channels_(channels),
         sample_rate_(sample_rate),
@@ -95,8 +98,12 @@ struct NoiseSuppression::Pimpl {
         return probability;
     }
 
-    void process(const AudioBuffer &input,
+    void process(const AudioBufferView &input,
                  AudioBuffer &output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != channels_) {
             throw std::invalid_argument("Expected an input frame with " + std::to_string(channels_) + " channels.");
         }
@@ -116,14 +123,24 @@ struct NoiseSuppression::Pimpl {
 
         output.setSampleRate(sample_rate_);
         output.resize(input.channels(), input.framesPerChannel());
-        for (auto i = 0ul; i < channels_; ++i) {
-            input_bands_ptr_[0] = input.channel(i);
-            output_bands_ptr_[0] = output.channel(i);
+        const auto process_channel = [&](std::size_t i) {
+            const std::array<const float*, 1> input_bands{input.channel(i)};
+            const std::array<float*, 1> output_bands{output.channel(i)};
             WebRtcNs_Analyze(handlers_[i]->core(), input.channel(i));
-            WebRtcNs_Process(handlers_[i]->core(), &input_bands_ptr_[0], 1, &output_bands_ptr_[0]);
+            WebRtcNs_Process(handlers_[i]->core(), input_bands.data(), 1, output_bands.data());
+        };
+
+        if (pool_ && ThreadPool::isWorthDispatching(input.size() * CostPerSample)) {
+            pool_->parallelFor(channels_, process_channel);
+        } else {
+            for (auto i = 0ul; i < channels_; ++i) {
+                process_channel(i);
+            }
         }
     }
 
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+
 
 
 private:
@@ -132,8 +149,6 @@ private:
     std::int8_t channels_{};
     std::vector<float> estimated_noise_;
     std::vector<std::unique_ptr<Handler>> handlers_{};
-    std::array<const float*, 1> input_bands_ptr_;
-    std::array<float*, 1> output_bands_ptr_;
 };
 
 NoiseSuppression::NoiseSuppression(std::int32_t sample_rate, std::int8_t channels, Policy policy)
@@ -146,7 +161,7 @@ void NoiseSuppression::reset() {
     pimpl_->reset();
 }
 
-void NoiseSuppression::process(const AudioBuffer &input,
+void NoiseSuppression::process(const AudioBufferView &input,
                                       AudioBuffer &output) {
     pimpl_->process(input, output);
 
@@ -164,6 +179,10 @@ const std::vector<float> &score::NoiseSuppression::estimatedNoise() const {
     return pimpl_->estimatedNoise();
 }
 
+void NoiseSuppression::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
 void NoiseSuppression::setPolicy(NoiseSuppression::Policy policy) {
     pimpl_->setPolicy(policy);
 }
@@ -82,7 +82,11 @@ struct Onset::Pimpl {
         aubio_onset_reset(tracker_);
     }
 
-    std::pair<bool, float> process(const AudioBuffer& input) {
+    std::pair<bool, float> process(const AudioBufferView& input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
                                         + std::to_string(sample_rate_) + " Hz");
@@ -94,7 +98,7 @@ struct Onset::Pimpl {
         }
 
 
-        const fvec_t in = {(unsigned int)input.size(), const_cast<float*>(input.data())};
+        const fvec_t in = {(unsigned int)input.size(), const_cast<float*>(input.channel(0))};
         aubio_onset_do(tracker_, &in, out_);
 
 
@@ -187,7 +191,7 @@ float score::Onset::delay() const {
     return pimpl_->delay();
 }
 
-std::pair<bool, float> score::Onset::process(const AudioBuffer &input) {
+std::pair<bool, float> score::Onset::process(const AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
@@ -0,0 +1,377 @@
+#include "pipeline.hpp"
+
+#include <stdexcept>
+
+using namespace score;
+
+constexpr Pipeline::Stage Pipeline::Source;
+constexpr Pipeline::Stage Pipeline::Previous;
+
+namespace {
+
+    constexpr auto NoBuffer = std::numeric_limits<std::size_t>::max();
+
+    bool operator==(const Pipeline::Format& lhs, const Pipeline::Format& rhs) {
+        return lhs.sample_rate == rhs.sample_rate && lhs.channels == rhs.channels
+               && lhs.frames_per_channel == rhs.frames_per_channel;
+    }
+
+    bool operator!=(const Pipeline::Format& lhs, const Pipeline::Format& rhs) {
+        return !(lhs == rhs);
+    }
+
+    Pipeline::Format formatOf(const AudioBufferView& frame) {
+        return Pipeline::Format{frame.sampleRate(), static_cast<std::int8_t>(frame.channels()),
+                                frame.framesPerChannel()};
+    }
+
+}
+
+struct Pipeline::Pimpl {
+
+    struct Node {
+        std::string name;
+        Stage parent;
+        Process process;
+        Consume consume;
+        Shape shape;
+        bool in_place;
+        Format format{};
+        std::size_t buffer{NoBuffer};
+        std::size_t last_consumer{0};
+        Combine combine{nullptr};
+        Stage reference{Previous};
+        bool external{false};
+        bool fed{false};
+
+        bool produces() const {
+            return process || combine;
+        }
+    };
+
+    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel) {
+        Node source{"source", Source, nullptr, nullptr, nullptr, false};
+        source.format = Format{sample_rate, channels, frames_per_channel};
+        nodes_.push_back(std::move(source));
+    }
+
+    Stage add(Node&& node) {
+        if (built_) {
+            throw std::runtime_error("The topology of the pipeline can not be modified once built.");
+        }
+
+        if (node.parent == Previous) {
+            node.parent = nodes_.size() - 1;
+        }
+
+        if (!producesFrames(node.parent)) {
+            throw std::invalid_argument("Expected a parent stage producing frames. Stage: " + node.name);
+        }
+
+        if (node.combine && !producesFrames(node.reference)) {
+            throw std::invalid_argument("Expected a reference stage producing frames. Stage: " + node.name);
+        }
+
+        nodes_.push_back(std::move(node));
+        return nodes_.size() - 1;
+    }
+
+    bool producesFrames(Stage stage) const {
+        return stage == Source || (stage < nodes_.size() && (nodes_[stage].external || nodes_[stage].produces()));
+    }
+
+    Stage source(const std::string& name, const Format& format) {
+        if (built_) {
+            throw std::runtime_error("The topology of the pipeline can not be modified once built.");
+        }
+
+        Node node{name, Source, nullptr, nullptr, nullptr, false};
+        node.format = format;
+        node.external = true;
+        nodes_.push_back(std::move(node));
+        return nodes_.size() - 1;
+    }
+
+    void feed(Stage stage, const AudioBufferView& frame) {
+        if (stage >= nodes_.size() || !nodes_[stage].external) {
+            throw std::invalid_argument("Expected an additional source of the pipeline.");
+        }
+
+        auto& node = nodes_[stage];
+        if (formatOf(frame) != node.format) {
+            throw std::invalid_argument("Expected a frame of " + std::to_string(node.format.sample_rate) + " Hz, "
+                                        + std::to_string(node.format.channels) + " channels and "
+                                        + std::to_string(node.format.frames_per_channel)
+                                        + " samples per channel in source " + node.name);
+        }
+
+        if (!built_) {
+            build();
+        }
+        views_[stage] = frame;
+        node.fed = true;
+    }
+
+    std::size_t acquire(const Format& format) {
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            const auto index = *it;
+            if (formats_[index] == format) {
+                free_.erase(it);
+                return index;
+            }
+        }
+
+        buffers_.emplace_back(format.sample_rate, format.channels, format.frames_per_channel);
+        formats_.push_back(format);
+        return buffers_.size() - 1;
+    }
+
+    void release(std::size_t buffer) {
+        if (buffer != NoBuffer) {
+            free_.push_back(buffer);
+        }
+    }
+
+    void build() {
+        if (built_) {
+            return;
+        }
+
+        // Infers the format of every stage and when its output is consumed for the last time.
+        for (auto i = 1ul; i < nodes_.size(); ++i) {
+            auto& node = nodes_[i];
+            if (node.external) {
+                continue;
+            }
+
+            auto& parent = nodes_[node.parent];
+            node.format = node.produces() ? node.shape(parent.format) : parent.format;
+            node.last_consumer = i;
+            parent.last_consumer = i;
+            if (node.combine) {
+                nodes_[node.reference].last_consumer = i;
+            }
+        }
+
+        // Assigns the buffers following the execution order, reusing the ones that are not needed anymore.
+        // Sources have no buffer, so releasing them does nothing.
+        for (auto i = 1ul; i < nodes_.size(); ++i) {
+            auto& node = nodes_[i];
+            if (node.external) {
+                continue;
+            }
+
+            auto& parent = nodes_[node.parent];
+            auto handed_over = false;
+            if (node.produces()) {
+                handed_over = node.in_place && parent.buffer != NoBuffer && parent.last_consumer == i
+                              && node.format == parent.format;
+                node.buffer = handed_over ? parent.buffer : acquire(node.format);
+            }
+
+            if (parent.last_consumer == i && !handed_over) {
+                release(parent.buffer);
+            }
+
+            if (node.combine && node.reference != node.parent && nodes_[node.reference].last_consumer == i) {
+                release(nodes_[node.reference].buffer);
+            }
+
+            if (node.produces() && node.last_consumer == i) {
+                release(node.buffer);
+            }
+        }
+
+        views_.resize(nodes_.size());
+        free_.clear();
+        built_ = true;
+        attach();
+    }
+
+    // Registers the stages once per profiler, so that setting the same profiler again does not duplicate them.
+    void attach() {
+        if (!profiler_ || !built_ || attached_.lock() == profiler_) {
+            return;
+        }
+
+        attached_ = profiler_;
+        probes_.clear();
+        probes_.reserve(nodes_.size());
+        probes_.push_back(profiler_->registerBlock("pipeline"));
+        for (auto i = 1ul; i < nodes_.size(); ++i) {
+            probes_.push_back(profiler_->registerBlock(nodes_[i].name));
+        }
+    }
+
+    void process(const AudioBufferView& input) {
+        if (!built_) {
+            build();
+        }
+
+        const auto& source = nodes_.front().format;
+        if (input.channels() != source.channels || input.framesPerChannel() != source.frames_per_channel) {
+            throw std::invalid_argument("Expected an input frame with " + std::to_string(source.channels)
+                                        + " channels and " + std::to_string(source.frames_per_channel)
+                                        + " samples per channel.");
+        }
+
+        if (profiler_ && profiler_->isEnabled()) {
+            Profiler::Scope scope(*profiler_, probes_.front());
+            run(input, profiler_.get());
+        } else {
+            run(input, nullptr);
+        }
+    }
+
+    void run(const AudioBufferView& input, Profiler* profiler) {
+        views_.front() = input;
+        for (auto& node : nodes_) {
+            if (node.external && !node.fed) {
+                throw std::runtime_error("Expected a frame for the source " + node.name + ". See feed().");
+            }
+            node.fed = false;
+        }
+
+        for (auto i = 1ul; i < nodes_.size(); ++i) {
+            auto& node = nodes_[i];
+            if (node.external) {
+                continue;
+            }
+
+            const auto& in = views_[node.parent];
+            if (!node.produces()) {
+                if (profiler != nullptr) {
+                    Profiler::Scope scope(*profiler, probes_[i]);
+                    node.consume(in);
+                    profiler->recordLatency(probes_[i], in.timestamp());
+                } else {
+                    node.consume(in);
+                }
+                continue;
+            }
+
+            auto& output = buffers_[node.buffer];
+            output.setTimestamp(in.timestamp());
+            output.setType(in.type());
+            if (profiler != nullptr) {
+                Profiler::Scope scope(*profiler, probes_[i]);
+                execute(node, in, output);
+            } else {
+                execute(node, in, output);
+            }
+
+            if (output.channels() != node.format.channels
+                || output.framesPerChannel() != node.format.frames_per_channel) {
+                throw std::runtime_error("Unexpected output format in stage " + node.name + ". Expected "
+                                         + std::to_string(node.format.channels) + " channels and "
+                                         + std::to_string(node.format.frames_per_channel)
+                                         + " samples per channel.");
+            }
+            views_[i] = AudioBufferView(output);
+        }
+    }
+
+    void execute(const Node& node, const AudioBufferView& input, AudioBuffer& output) {
+        if (node.combine) {
+            node.combine(input, views_[node.reference], output);
+        } else {
+            node.process(input, output);
+        }
+    }
+
+    bool built_{false};
+    std::vector<Node> nodes_{};
+    std::vector<AudioBuffer> buffers_{};
+    std::vector<Format> formats_{};
+    std::vector<std::size_t> free_{};
+    std::vector<AudioBufferView> views_{};
+    std::shared_ptr<Profiler> profiler_{nullptr};
+    std::vector<Profiler::Probe> probes_{};
+    std::weak_ptr<Profiler> attached_{};
+};
+
+score::Pipeline::Pipeline(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_channel) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, frames_per_channel)) {
+
+}
+
+score::Pipeline::~Pipeline() = default;
+
+Pipeline::Stage score::Pipeline::add(const std::string &name, const Process &process, Stage parent,
+        const Shape &shape, bool in_place) {
+    return pimpl_->add(Pimpl::Node{name, parent, process, nullptr, shape, in_place});
+}
+
+Pipeline::Stage score::Pipeline::source(const std::string &name, std::int32_t sample_rate, std::int8_t channels,
+        std::size_t frames_per_channel) {
+    return pimpl_->source(name, Format{sample_rate, channels, frames_per_channel});
+}
+
+Pipeline::Stage score::Pipeline::combine(const std::string &name, const Combine &combine, Stage parent,
+        Stage reference, const Shape &shape) {
+    Pimpl::Node node{name, parent, nullptr, nullptr, shape, false};
+    node.combine = combine;
+    node.reference = reference == Previous ? pimpl_->nodes_.size() - 1 : reference;
+    return pimpl_->add(std::move(node));
+}
+
+Pipeline::Stage score::Pipeline::sink(const std::string &name, const Consume &consume, Stage parent) {
+    return pimpl_->add(Pimpl::Node{name, parent, nullptr, consume, nullptr, false});
+}
+
+void score::Pipeline::build() {
+    pimpl_->build();
+}
+
+bool score::Pipeline::isBuilt() const {
+    return pimpl_->built_;
+}
+
+void score::Pipeline::feed(Stage source, const AudioBufferView &frame) {
+    pimpl_->feed(source, frame);
+}
+
+void score::Pipeline::process(const AudioBufferView &input) {
+    pimpl_->process(input);
+}
+
+void score::Pipeline::setProfiler(const std::shared_ptr<Profiler> &profiler) {
+    pimpl_->profiler_ = profiler;
+    pimpl_->attach();
+}
+
+std::size_t score::Pipeline::stages() const {
+    return pimpl_->nodes_.size();
+}
+
+const std::string &score::Pipeline::name(Stage stage) const {
+    return pimpl_->nodes_.at(stage).name;
+}
+
+Pipeline::Format score::Pipeline::format(Stage stage) const {
+    return pimpl_->nodes_.at(stage).format;
+}
+
+std::size_t score::Pipeline::buffers() const {
+    return pimpl_->buffers_.size();
+}
+
+Pipeline::Shape score::Pipeline::SameFormat() {
+    return [](const Format& input) {
+        return input;
+    };
+}
+
+Pipeline::Shape score::Pipeline::ChannelsFormat(std::int8_t channels) {
+    return [channels](const Format& input) {
+        return Format{input.sample_rate, channels, input.frames_per_channel};
+    };
+}
+
+Pipeline::Shape score::Pipeline::SampleRateFormat(std::int32_t sample_rate) {
+    return [sample_rate](const Format& input) {
+        const auto frames = static_cast<std::size_t>(static_cast<std::int64_t>(input.frames_per_channel)
+                                                     * sample_rate / input.sample_rate);
+        return Format{sample_rate, input.channels, frames};
+    };
+}
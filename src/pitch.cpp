@@ -47,7 +47,11 @@ struct Pitch::Pimpl {
     }
 
 
-    std::pair<float, float> process(const AudioBuffer& input) {
+    std::pair<float, float> process(const AudioBufferView& input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
                                         + std::to_string(sample_rate_) + " Hz");
@@ -59,7 +63,7 @@ struct Pitch::Pimpl {
         }
 
 
-        const fvec_t in = {(unsigned int)input.size(), const_cast<float*>(input.data())};
+        const fvec_t in = {(unsigned int)input.size(), const_cast<float*>(input.channel(0))};
         aubio_pitch_do(tracker_, &in, out_);
 
         return {out_->data[0], aubio_pitch_get_confidence(tracker_)};
@@ -125,6 +129,6 @@ float score::Pitch::silenceLevel() const {
     return pimpl_->silenceLevel();
 }
 
-std::pair<float, float> score::Pitch::process(const AudioBuffer &input) {
+std::pair<float, float> score::Pitch::process(const AudioBufferView &input) {
     return pimpl_->process(input);
 }
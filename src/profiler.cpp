@@ -0,0 +1,231 @@
+#include "profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    /**
+     * Log-linear histogram of positive durations in nanoseconds: every power of two is split in 4 buckets, so the
+     * percentiles are estimated with a relative error below 12.5%.
+     */
+    class Histogram {
+    public:
+        static constexpr std::size_t SubBuckets = 4;
+        static constexpr std::size_t Buckets = 64 * SubBuckets;
+
+        void record(std::int64_t value) {
+            const auto sample = static_cast<std::uint64_t>(value > 0 ? value : 0);
+            buckets_[index(sample)].fetch_add(1, std::memory_order_relaxed);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            auto current = max_.load(std::memory_order_relaxed);
+            while (sample > current && !max_.compare_exchange_weak(current, sample, std::memory_order_relaxed)) {}
+        }
+
+        Profiler::Distribution summary() const {
+            const auto count = count_.load(std::memory_order_relaxed);
+            if (count == 0) {
+                return Profiler::Distribution{0, 0, 0};
+            }
+
+            const auto max = max_.load(std::memory_order_relaxed);
+            return Profiler::Distribution{percentile(count, 0.50, max) * 1e-3,
+                                          percentile(count, 0.99, max) * 1e-3,
+                                          static_cast<double>(max) * 1e-3};
+        }
+
+        void reset() {
+            for (auto& bucket : buckets_) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+            count_.store(0, std::memory_order_relaxed);
+            max_.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static std::size_t index(std::uint64_t value) {
+            if (value < SubBuckets) {
+                return static_cast<std::size_t>(value);
+            }
+            const auto exponent = static_cast<std::size_t>(63 - __builtin_clzll(value));
+            const auto sub = static_cast<std::size_t>(value >> (exponent - 2)) & (SubBuckets - 1);
+            return (exponent - 1) * SubBuckets + sub;
+        }
+
+        static double middle(std::size_t index) {
+            if (index < SubBuckets) {
+                return static_cast<double>(index);
+            }
+            const auto exponent = index / SubBuckets + 1;
+            const auto sub = index % SubBuckets;
+            const auto lower = static_cast<double>((SubBuckets + sub) << (exponent - 2));
+            const auto width = static_cast<double>(1ull << (exponent - 2));
+            return lower + 0.5 * (width - 1);
+        }
+
+        double percentile(std::uint64_t count, double quantile, std::uint64_t max) const {
+            const auto target = static_cast<std::uint64_t>(quantile * static_cast<double>(count - 1)) + 1;
+            std::uint64_t accumulated = 0;
+            for (auto i = 0ul; i < Buckets; ++i) {
+                accumulated += buckets_[i].load(std::memory_order_relaxed);
+                if (accumulated >= target) {
+                    return std::min(middle(i), static_cast<double>(max));
+                }
+            }
+            return static_cast<double>(max);
+        }
+
+        std::array<std::atomic<std::uint64_t>, Buckets> buckets_{};
+        std::atomic<std::uint64_t> count_{0};
+        std::atomic<std::uint64_t> max_{0};
+    };
+
+    constexpr std::size_t Histogram::SubBuckets;
+    constexpr std::size_t Histogram::Buckets;
+
+    void write(std::ostringstream& stream, const char* key, const Profiler::Distribution& distribution) {
+        stream << "\"" << key << "\": {\"p50\": " << distribution.p50 << ", \"p99\": " << distribution.p99
+               << ", \"max\": " << distribution.max << "}";
+    }
+
+    std::string escape(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const auto character : text) {
+            if (character == '"' || character == '\\') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(character);
+        }
+        return escaped;
+    }
+
+}
+
+struct Profiler::Pimpl {
+
+    struct Entry {
+        explicit Entry(const std::string& name) : name(name) {}
+
+        std::string name;
+        std::atomic<std::uint64_t> frames{0};
+        std::atomic<std::uint64_t> dropped{0};
+        Histogram wall{};
+        Histogram cpu{};
+        Histogram latency{};
+    };
+
+    Probe registerBlock(const std::string& name) {
+        entries_.push_back(std::make_unique<Entry>(name));
+        return entries_.size() - 1;
+    }
+
+    Entry& entry(Probe probe) {
+        if (probe >= entries_.size()) {
+            throw std::invalid_argument("Expected a registered probe. Probe: " + std::to_string(probe));
+        }
+        return *entries_[probe];
+    }
+
+    std::vector<std::unique_ptr<Entry>> entries_{};
+    std::function<double()> clock_{nullptr};
+};
+
+score::Profiler::Profiler(bool enabled) :
+    enabled_(enabled),
+    pimpl_(std::make_unique<Pimpl>()) {
+
+}
+
+score::Profiler::~Profiler() = default;
+
+Profiler::Probe score::Profiler::registerBlock(const std::string &name) {
+    return pimpl_->registerBlock(name);
+}
+
+void score::Profiler::setClock(const std::function<double()> &clock) {
+    pimpl_->clock_ = clock;
+}
+
+void score::Profiler::recordTime(Profiler::Probe probe, std::int64_t wall_ns, std::int64_t cpu_ns) {
+    auto& entry = pimpl_->entry(probe);
+    entry.frames.fetch_add(1, std::memory_order_relaxed);
+    entry.wall.record(wall_ns);
+    entry.cpu.record(cpu_ns);
+}
+
+void score::Profiler::recordLatency(Profiler::Probe probe, double timestamp) {
+    if (!isEnabled() || !pimpl_->clock_) {
+        return;
+    }
+    const auto latency = pimpl_->clock_() - timestamp;
+    pimpl_->entry(probe).latency.record(static_cast<std::int64_t>(latency * 1e9));
+}
+
+void score::Profiler::recordDropped(Profiler::Probe probe, std::uint64_t frames) {
+    if (!isEnabled()) {
+        return;
+    }
+    pimpl_->entry(probe).dropped.fetch_add(frames, std::memory_order_relaxed);
+}
+
+std::vector<Profiler::Statistics> score::Profiler::snapshot() const {
+    std::vector<Statistics> statistics;
+    statistics.reserve(pimpl_->entries_.size());
+    for (const auto& entry : pimpl_->entries_) {
+        statistics.push_back(Statistics{entry->name,
+                                        entry->frames.load(std::memory_order_relaxed),
+                                        entry->dropped.load(std::memory_order_relaxed),
+                                        entry->wall.summary(),
+                                        entry->cpu.summary(),
+                                        entry->latency.summary()});
+    }
+    return statistics;
+}
+
+std::string score::Profiler::toJson() const {
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(3) << "{\"unit\": \"us\", \"blocks\": [";
+    const auto statistics = snapshot();
+    for (auto i = 0ul; i < statistics.size(); ++i) {
+        const auto& block = statistics[i];
+        stream << (i == 0 ? "" : ", ") << "{\"name\": \"" << escape(block.name) << "\", \"frames\": "
+               << block.frames << ", \"dropped\": " << block.dropped << ", ";
+        write(stream, "wall", block.wall);
+        stream << ", ";
+        write(stream, "cpu", block.cpu);
+        stream << ", ";
+        write(stream, "latency", block.latency);
+        stream << "}";
+    }
+    stream << "]}";
+    return stream.str();
+}
+
+void score::Profiler::reset() {
+    for (auto& entry : pimpl_->entries_) {
+        entry->frames.store(0, std::memory_order_relaxed);
+        entry->dropped.store(0, std::memory_order_relaxed);
+        entry->wall.reset();
+        entry->cpu.reset();
+        entry->latency.reset();
+    }
+}
+
+std::int64_t score::Profiler::WallTime() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::int64_t score::Profiler::CpuTime() {
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<std::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+}
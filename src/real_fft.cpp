@@ -0,0 +1,93 @@
+#include "real_fft.hpp"
+
+#include <fftw3.h>
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace score;
+
+namespace {
+
+    struct Plans {
+        fftwf_plan forward;
+        fftwf_plan backward;
+    };
+
+    /**
+     * The plans are created once per size and kept alive until the end of the program. They are unaligned so
+     * they can be executed on any array.
+     */
+    Plans plans(std::size_t size) {
+        static std::mutex mutex;
+        static std::map<std::size_t, Plans> cache;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = cache.find(size);
+        if (it != cache.end()) {
+            return it->second;
+        }
+
+        std::vector<float> real(size);
+        std::vector<std::complex<float>> spectrum(size / 2 + 1);
+        auto* complex = reinterpret_cast<fftwf_complex*>(spectrum.data());
+        const auto n = static_cast<int>(size);
+        const auto flags = FFTW_ESTIMATE | FFTW_UNALIGNED;
+        const Plans created{fftwf_plan_dft_r2c_1d(n, real.data(), complex, flags),
+                            fftwf_plan_dft_c2r_1d(n, complex, real.data(), flags)};
+        if (created.forward == nullptr || created.backward == nullptr) {
+            throw std::runtime_error("Error while creating the FFTW plans of size " + std::to_string(size));
+        }
+        cache.emplace(size, created);
+        return created;
+    }
+
+}
+
+struct RealFFT::Pimpl {
+
+    explicit Pimpl(std::size_t size) :
+        size_(size),
+        bins_(size / 2 + 1) {
+        if (size_ == 0) {
+            throw std::invalid_argument("Expected a transform of at least one sample.");
+        }
+        plans_ = plans(size_);
+        scratch_.resize(bins_);
+    }
+
+    std::size_t size_;
+    std::size_t bins_;
+    Plans plans_{};
+    std::vector<std::complex<float>> scratch_{};
+};
+
+score::RealFFT::RealFFT(std::size_t size) :
+    pimpl_(std::make_unique<Pimpl>(size)) {
+
+}
+
+score::RealFFT::~RealFFT() = default;
+
+std::size_t score::RealFFT::size() const {
+    return pimpl_->size_;
+}
+
+std::size_t score::RealFFT::bins() const {
+    return pimpl_->bins_;
+}
+
+void score::RealFFT::forward(const float *input, std::complex<float> *output) {
+    // The out-of-place real-to-complex transforms preserve their input.
+    fftwf_execute_dft_r2c(pimpl_->plans_.forward, const_cast<float*>(input),
+                          reinterpret_cast<fftwf_complex*>(output));
+}
+
+void score::RealFFT::inverse(const std::complex<float> *input, float *output) {
+    // The complex-to-real transforms destroy their input.
+    std::copy(input, input + pimpl_->bins_, pimpl_->scratch_.begin());
+    fftwf_execute_dft_c2r(pimpl_->plans_.backward, reinterpret_cast<fftwf_complex*>(pimpl_->scratch_.data()),
+                          output);
+}
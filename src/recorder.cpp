@@ -1,7 +1,13 @@
 
 #include "recorder.hpp"
+#include "ring_buffer.hpp"
 #include <portaudio.h>
+#include <semaphore.h>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <cerrno>
+#include <ctime>
 
 using namespace score;
 
@@ -14,9 +20,18 @@ struct Recorder::Pimpl {
         sample_rate_(sample_rate),
         record_buffer_(sample_rate, channels, frames_per_buffer)
         {
+        sem_init(&ready_, 0, 0);
         restart();
     }
 
+    ~Pimpl() {
+        if (stream_ != nullptr && isRunning()) {
+            Pa_StopStream(stream_);
+        }
+        stopWorker();
+        sem_destroy(&ready_);
+    }
+
     static int PortAudioCallback(const void *inputBuffer,
                                  void *outputBuffer,
                                  unsigned long framesPerBuffer,
@@ -38,6 +53,10 @@ struct Recorder::Pimpl {
         on_buffer_ready_ = callback;
     }
 
+    void setOnProcessingViewReady(const std::function<void(AudioBufferView& view)>& callback) {
+        on_view_ready_ = callback;
+    }
+
     void restart() {
         input_params_.channelCount = static_cast<int>(channels_);
         input_params_.device = device_index_;
@@ -58,6 +77,10 @@ struct Recorder::Pimpl {
             return true;
         }
 
+        if (asynchronous_) {
+            startWorker();
+        }
+
         if (auto err = Pa_StartStream(stream_) != paNoError) {
             throw std::runtime_error(Pa_GetErrorText(err));
         }
@@ -77,6 +100,7 @@ struct Recorder::Pimpl {
         if (auto err =  Pa_StopStream(stream_) != paNoError ) {
             throw std::runtime_error(Pa_GetErrorText(err));
         }
+        stopWorker();
 
         const bool stoped = !isRunning();
         if (stoped) {
@@ -93,12 +117,137 @@ struct Recorder::Pimpl {
                      PaStreamCallbackFlags statusFlags) {
 
         auto *ptr = (const float *) inputBuffer;
-        record_buffer_.fromInterleave(channels_, frames_per_buffer_, ptr);
-        record_buffer_.setTimestamp(timeInfo->currentTime + timeInfo->inputBufferAdcTime);
-        on_buffer_ready_(record_buffer_);
+        // The ADC time is already expressed in the time base of Pa_GetStreamTime, see timestamp().
+        const auto timestamp = timeInfo->inputBufferAdcTime;
+        if (asynchronous_) {
+            enqueue(ptr, timestamp);
+            return paContinue;
+        }
+
+        deliver(const_cast<float*>(ptr), timestamp);
         return paContinue;
     }
 
+    // The view wraps the interleaved samples as they are, the buffer is only filled if someone listens to it.
+    void deliver(float* interleaved, double timestamp) {
+        if (on_view_ready_) {
+            auto view = AudioBufferView::FromInterleave(sample_rate_, channels_, frames_per_buffer_, interleaved);
+            view.setTimestamp(timestamp);
+            on_view_ready_(view);
+        }
+
+        if (on_buffer_ready_) {
+            record_buffer_.fromInterleave(channels_, frames_per_buffer_, interleaved);
+            record_buffer_.setTimestamp(timestamp);
+            on_buffer_ready_(record_buffer_);
+        }
+    }
+
+    // Runs in the audio thread: it must not allocate, lock or block.
+    void enqueue(const float* interleaved, double timestamp) {
+        if (timestamps_->space() == 0 || !samples_->write(interleaved, interleaved_.size())) {
+            overflows_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        timestamps_->write(&timestamp, 1);
+        const auto queued = timestamps_->available();
+        if (queued > peak_.load(std::memory_order_relaxed)) {
+            peak_.store(queued, std::memory_order_relaxed);
+        }
+        sem_post(&ready_);
+    }
+
+    bool waitBuffer() {
+        const auto timeout = static_cast<long>(2e9 * frames_per_buffer_ / sample_rate_);
+        timespec deadline{};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += (deadline.tv_nsec + timeout) / 1000000000L;
+        deadline.tv_nsec = (deadline.tv_nsec + timeout) % 1000000000L;
+        while (sem_timedwait(&ready_, &deadline) != 0) {
+            if (errno != EINTR) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void consume() {
+        auto delivered = false;
+        while (true) {
+            if (!waitBuffer()) {
+                if (!running_.load(std::memory_order_acquire)) {
+                    break;
+                }
+
+                if (delivered) {
+                    underflows_.fetch_add(1, std::memory_order_relaxed);
+                }
+                continue;
+            }
+
+            double timestamp = 0;
+            if (!timestamps_->read(&timestamp, 1)) {
+                if (!running_.load(std::memory_order_acquire)) {
+                    break;
+                }
+                continue;
+            }
+
+            samples_->read(interleaved_.data(), interleaved_.size());
+            deliver(interleaved_.data(), timestamp);
+            delivered = true;
+        }
+    }
+
+    void startWorker() {
+        stopWorker();
+        samples_->reset();
+        timestamps_->reset();
+        while (sem_trywait(&ready_) == 0) {}
+        overflows_ = 0;
+        underflows_ = 0;
+        peak_ = 0;
+        running_ = true;
+        worker_ = std::thread(&Pimpl::consume, this);
+    }
+
+    void stopWorker() {
+        if (!worker_.joinable()) {
+            return;
+        }
+
+        running_ = false;
+        sem_post(&ready_);
+        worker_.join();
+    }
+
+    void allocateQueue() {
+        interleaved_.resize(channels_ * frames_per_buffer_);
+        samples_ = std::make_unique<RingBuffer<float>>(queue_size_ * interleaved_.size());
+        timestamps_ = std::make_unique<RingBuffer<double>>(queue_size_);
+    }
+
+    void setAsynchronous(bool enabled, std::size_t queue_size) {
+        if (isRunning()) {
+            throw std::runtime_error("The asynchronous mode can not be modified while recording.");
+        }
+
+        if (queue_size == 0) {
+            throw std::invalid_argument("Expected a queue of at least one buffer.");
+        }
+
+        asynchronous_ = enabled;
+        queue_size_ = queue_size;
+        allocateQueue();
+    }
+
+    QueueStatistics queueStatistics() const {
+        return QueueStatistics{overflows_.load(std::memory_order_relaxed),
+                               underflows_.load(std::memory_order_relaxed),
+                               peak_.load(std::memory_order_relaxed)};
+    }
+
     bool isSampleRateSupported(std::int32_t sample_rate) {
         PaStreamParameters output_params;
         output_params.channelCount = 2;
@@ -131,8 +280,16 @@ struct Recorder::Pimpl {
     }
 
     void setFramesPerBuffer(std::size_t frames_per_buffer) {
+        // The audio callback writes into the queue, it can not be reallocated under a running stream.
+        if (isRunning()) {
+            throw std::runtime_error("The number of frames per buffer can not be modified while recording.");
+        }
+
         frames_per_buffer_ = frames_per_buffer;
         record_buffer_.resize(channels_, frames_per_buffer);
+        if (asynchronous_) {
+            allocateQueue();
+        }
     }
 
     bool isRunning() const {
@@ -156,7 +313,19 @@ struct Recorder::Pimpl {
     std::function<void()> on_recording_started_{nullptr};
     std::function<void()> on_recording_stopped_{nullptr};
     std::function<void(AudioBuffer& buffer)> on_buffer_ready_{nullptr};
-
+    std::function<void(AudioBufferView& view)> on_view_ready_{nullptr};
+
+    bool asynchronous_{false};
+    std::size_t queue_size_{0};
+    std::vector<float> interleaved_{};
+    std::unique_ptr<RingBuffer<float>> samples_{};
+    std::unique_ptr<RingBuffer<double>> timestamps_{};
+    std::thread worker_{};
+    std::atomic<bool> running_{false};
+    std::atomic<std::size_t> overflows_{0};
+    std::atomic<std::size_t> underflows_{0};
+    std::atomic<std::size_t> peak_{0};
+    sem_t ready_{};
 };
 
 Recorder::Recorder(std::int32_t sample_rate, std::int8_t channels,  int device_index, std::size_t frames_per_buffer) :
@@ -192,6 +361,22 @@ void Recorder::setOnProcessingBufferReady(const std::function<void(AudioBuffer&
     pimpl_->setOnProcessingBufferReady(callback);
 }
 
+void Recorder::setOnProcessingViewReady(const std::function<void(AudioBufferView& view)> &callback) {
+    pimpl_->setOnProcessingViewReady(callback);
+}
+
+void Recorder::setAsynchronous(bool enabled, std::size_t queue_size) {
+    pimpl_->setAsynchronous(enabled, queue_size);
+}
+
+bool Recorder::isAsynchronous() const {
+    return pimpl_->asynchronous_;
+}
+
+Recorder::QueueStatistics Recorder::queueStatistics() const {
+    return pimpl_->queueStatistics();
+}
+
 int Recorder::deviceIndex() const {
     return pimpl_->device_index_;
 }
@@ -228,8 +413,8 @@ bool Recorder::stop() {
     return pimpl_->stop();
 }
 
-float Recorder::timestamp() const {
-    return static_cast<float>(pimpl_->timestamp());
+double Recorder::timestamp() const {
+    return pimpl_->timestamp();
 }
 
 std::string Recorder::deviceName() const {
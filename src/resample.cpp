@@ -15,7 +15,11 @@ struct ReSampler::Pimpl {
     }
 
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.channels() != channels_) {
             throw std::invalid_argument("Expected an input frame with " + std::to_string(channels_) + " channels.");
@@ -65,7 +69,7 @@ void ReSampler::reset() {
 }
 
 
-void ReSampler::process(const AudioBuffer& input, AudioBuffer& output) {
+void ReSampler::process(const AudioBufferView& input, AudioBuffer& output) {
     pimpl_->process(input, output);
 }
 
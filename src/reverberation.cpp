@@ -346,7 +346,11 @@ struct Reverberation::Pimpl {
     }
 
 
-    void process(const AudioBuffer &input, AudioBuffer &output) {
+    void process(const AudioBufferView &input, AudioBuffer &output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
@@ -482,7 +486,7 @@ const Matrix<float>& Reverberation::RIR() const {
     return pimpl_->rir_;
 }
 
-void Reverberation::process(const AudioBuffer &recorded, AudioBuffer &output) {
+void Reverberation::process(const AudioBufferView &recorded, AudioBuffer &output) {
     pimpl_->process(recorded, output);
 }
 
@@ -47,7 +47,11 @@ struct DeepNoiseSuppression::Pimpl {
         }
     }
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != channels_) {
             throw std::invalid_argument("Expected an input frame with " + std::to_string(channels_) + " channels.");
         }
@@ -81,7 +85,7 @@ DeepNoiseSuppression::DeepNoiseSuppression(std::int8_t channels) : pimpl_(std::m
 
 DeepNoiseSuppression::~DeepNoiseSuppression() = default;
 
-void DeepNoiseSuppression::process(const AudioBuffer& input, AudioBuffer& output) {
+void DeepNoiseSuppression::process(const AudioBufferView& input, AudioBuffer& output) {
     pimpl_->process(input, output);
 }
 
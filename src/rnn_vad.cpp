@@ -5,7 +5,11 @@
 
 struct score::DeepVAD::Pimpl {
 
-    bool process(const AudioBuffer& input) {
+    bool process(const AudioBufferView& input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         constexpr auto DefaultSampleRate = 24000;
         constexpr auto DefaultBufferSize = 240;
 
@@ -23,7 +27,7 @@ struct score::DeepVAD::Pimpl {
                                         + std::to_string(webrtc::rnn_vad::kFrameSize10ms24kHz) + " samples.");
         }
 
-        is_silence_ = features_extractor_.CheckSilenceComputeFeatures({input.data(), input.size()}, feature_vector_);
+        is_silence_ = features_extractor_.CheckSilenceComputeFeatures({input.channel(0), input.size()}, feature_vector_);
         vad_probability_ = vad_.ComputeVadProbability(feature_vector_, is_silence_);
         return is_silence_;
     }
@@ -46,7 +50,7 @@ void score::DeepVAD::reset() {
     pimpl_->features_extractor_.Reset();
 }
 
-bool score::DeepVAD::process(const score::AudioBuffer &input) {
+bool score::DeepVAD::process(const score::AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
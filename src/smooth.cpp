@@ -11,7 +11,11 @@ struct Smooth::Pimpl {
             filter = std::make_unique<edsp::filter::moving_average<float>>(window_size);
     }
 
-    void process(const AudioBuffer& input, AudioBuffer& output) {
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
         if (input.channels() != filters_.size()) {
             throw std::invalid_argument("Expected an input frame with "
                                         + std::to_string(filters_.size()) + " channels.");
@@ -47,7 +51,7 @@ score::Smooth::Smooth(std::int8_t channels, std::size_t window_size) :
  
 }
 
-void score::Smooth::process(const AudioBuffer &input, AudioBuffer &output) {
+void score::Smooth::process(const AudioBufferView &input, AudioBuffer &output) {
     pimpl_->process(input, output);
 }
 
@@ -0,0 +1,211 @@
+#include "speex_preprocessor.hpp"
+#include "acoustic_echo_canceller_internal.hpp"
+#include "utils.hpp"
+#include <speex/speex_preprocess.h>
+
+using namespace score;
+
+struct SpeexPreprocessor::Pimpl {
+
+    // Cost in nanoseconds per sample, see ThreadPool::MinimumParallelWork.
+    static constexpr auto CostPerSample = 100ul;
+
+    struct Handler {
+
+        Handler(std::int32_t sample_rate, std::size_t frame_size, int features) {
+            state_ = speex_preprocess_state_init(static_cast<int>(frame_size), static_cast<int>(sample_rate));
+            if (state_ == nullptr) {
+                throw std::bad_alloc();
+            }
+
+            int disable = 0;
+            int denoise = (features & Denoise) != 0;
+            int dereverb = (features & DeReverb) != 0;
+            int vad = (features & VoiceDetection) != 0;
+            speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_AGC, &disable);
+            speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_DENOISE, &denoise);
+            speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_DEREVERB, &dereverb);
+            speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_VAD, &vad);
+            speex_preprocess_ctl(state_, SPEEX_PREPROCESS_SET_ECHO_STATE, nullptr);
+        }
+
+        ~Handler() {
+            speex_preprocess_state_destroy(state_);
+        }
+
+        SpeexPreprocessState* state_{nullptr};
+        bool voice_{false};
+    };
+
+    Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frame_size, int features) :
+        features_(features),
+        sample_rate_(sample_rate),
+        channels_(channels),
+        handlers_(static_cast<std::size_t>(std::max<std::int8_t>(channels, 0))) {
+
+        if (channels <= 0) {
+            throw std::invalid_argument("Expected a positive number of channels.");
+        }
+
+        if (frame_size == 0 || frame_size > 0.02 * sample_rate) {
+            throw std::invalid_argument("Number of samples to process at one time "
+                                        "(should correspond to 10-20 ms)");
+        }
+
+        if ((features & ~(Denoise | DeReverb | EchoSuppression | VoiceDetection)) != 0) {
+            throw std::invalid_argument("Expected a combination of the features of the SpeexPreprocessor.");
+        }
+
+        temp_.resize(channels, static_cast<Eigen::Index>(frame_size));
+        for (auto& handler : handlers_) {
+            handler = std::make_unique<Handler>(sample_rate, frame_size, features);
+        }
+    }
+
+    void setEchoCanceller(const AEC& aec) {
+        // The residual echo of the canceller is written in a buffer sized after the frame of the preprocessor.
+        const auto frame_size = static_cast<Eigen::Index>(AECInternals::frameSize(aec));
+        if (AECInternals::sampleRate(aec) != sample_rate_ || frame_size != temp_.cols()) {
+            throw std::invalid_argument("Expected an echo canceller working at " + std::to_string(sample_rate_)
+                                        + " Hz with " + std::to_string(temp_.cols()) + " frames per buffer.");
+        }
+
+        const auto states = AECInternals::speexStates(aec);
+        if (states.size() != handlers_.size()) {
+            throw std::invalid_argument("The SpeexPreprocessor is configure to work with "
+                                        + std::to_string(channels_) + " channels.");
+        }
+
+        for (auto i = 0ul; i < handlers_.size(); ++i) {
+            speex_preprocess_ctl(handlers_[i]->state_, SPEEX_PREPROCESS_SET_ECHO_STATE, states[i]);
+        }
+        linked_ = true;
+    }
+
+    void process(const AudioBufferView& input, AudioBuffer& output) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
+        if (input.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected "
+                                        + std::to_string(sample_rate_) + " Hz");
+        }
+
+        if (channels_ != input.channels()) {
+            throw std::invalid_argument("The SpeexPreprocessor is configure to work with "
+                                        + std::to_string(channels_) + " channels.");
+        }
+
+        if (input.framesPerChannel() != temp_.cols()) {
+            throw std::invalid_argument("The SpeexPreprocessor is configure to work with "
+                                        + std::to_string(temp_.cols()) + " frames per buffer.");
+        }
+
+        if ((features_ & EchoSuppression) != 0 && !linked_) {
+            throw std::runtime_error("The residual echo suppression requires an echo canceller.");
+        }
+
+        output.setSampleRate(input.sampleRate());
+        output.resize(input.channels(), input.framesPerChannel());
+        const auto process_channel = [&](std::size_t i) {
+            auto* temp = temp_.row(i).data();
+            Converter::FloatS16ToS16(input.channel(i), input.framesPerChannel(), temp);
+            handlers_[i]->voice_ = speex_preprocess_run(handlers_[i]->state_, temp) != 0;
+            Converter::S16ToFloatS16(temp, output.framesPerChannel(), output.channel(i));
+        };
+
+        if (pool_ && ThreadPool::isWorthDispatching(input.size() * CostPerSample)) {
+            pool_->parallelFor(channels_, process_channel);
+        } else {
+            for (auto i = 0ul; i < channels_; ++i) {
+                process_channel(i);
+            }
+        }
+    }
+
+    void set(int request, int value) {
+        for (auto& h : handlers_) {
+            speex_preprocess_ctl(h->state_, request, &value);
+        }
+    }
+
+    int get(int request) const {
+        int value = 0;
+        speex_preprocess_ctl(handlers_.front()->state_, request, &value);
+        return value;
+    }
+
+    bool isVoice(std::size_t channel) const {
+        if ((features_ & VoiceDetection) == 0) {
+            throw std::runtime_error("The voice activity detection is not enabled.");
+        }
+
+        if (channel >= handlers_.size()) {
+            throw std::invalid_argument("Expected a channel in the range [0, " + std::to_string(channels_) + ").");
+        }
+        return handlers_[channel]->voice_;
+    }
+
+    std::shared_ptr<ThreadPool> pool_{nullptr};
+    int features_;
+
+private:
+    std::int32_t sample_rate_;
+    std::int8_t channels_;
+    bool linked_{false};
+    std::vector<std::unique_ptr<Handler>> handlers_;
+    Matrix<std::int16_t> temp_{};
+};
+
+score::SpeexPreprocessor::SpeexPreprocessor(std::int32_t sample_rate, std::int8_t channels,
+        std::size_t frames_per_buffer, int features) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, channels, frames_per_buffer, features)) {
+
+}
+
+int score::SpeexPreprocessor::features() const {
+    return pimpl_->features_;
+}
+
+void score::SpeexPreprocessor::setEchoCanceller(const AEC &aec) {
+    pimpl_->setEchoCanceller(aec);
+}
+
+void score::SpeexPreprocessor::setNoiseSuppression(int attenuation_db) {
+    pimpl_->set(SPEEX_PREPROCESS_SET_NOISE_SUPPRESS, attenuation_db);
+}
+
+int score::SpeexPreprocessor::noiseSuppression() const {
+    return pimpl_->get(SPEEX_PREPROCESS_GET_NOISE_SUPPRESS);
+}
+
+void score::SpeexPreprocessor::setMaximumAttenuation(int attenuation_db) {
+    pimpl_->set(SPEEX_PREPROCESS_SET_ECHO_SUPPRESS, attenuation_db);
+}
+
+int score::SpeexPreprocessor::maximumAttenuation() const {
+    return pimpl_->get(SPEEX_PREPROCESS_GET_ECHO_SUPPRESS);
+}
+
+void score::SpeexPreprocessor::setMaximumAttenuationNearEnd(int attenuation_db) {
+    pimpl_->set(SPEEX_PREPROCESS_SET_ECHO_SUPPRESS_ACTIVE, attenuation_db);
+}
+
+int score::SpeexPreprocessor::maximumAttenuationNearEnd() const {
+    return pimpl_->get(SPEEX_PREPROCESS_GET_ECHO_SUPPRESS_ACTIVE);
+}
+
+bool score::SpeexPreprocessor::isVoice(std::size_t channel) const {
+    return pimpl_->isVoice(channel);
+}
+
+void score::SpeexPreprocessor::process(const AudioBufferView &input, AudioBuffer &output) {
+    pimpl_->process(input, output);
+}
+
+void score::SpeexPreprocessor::setThreadPool(const std::shared_ptr<ThreadPool> &pool) {
+    pimpl_->pool_ = pool;
+}
+
+score::SpeexPreprocessor::~SpeexPreprocessor() = default;
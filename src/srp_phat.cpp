@@ -0,0 +1,234 @@
+#include "srp_phat.hpp"
+#include "gcc_phat.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    /**
+     * Steering table of a grid of directions: for every pair of microphones and every direction, the index of the
+     * correlation sample right before the expected delay and the fractional part of the delay.
+     */
+    struct Grid {
+        std::size_t azimuths{0};
+        std::vector<float> elevations{};
+        Matrix<std::int32_t> index{};
+        Matrix<float> fraction{};
+        Vector<float> power{};
+
+        std::size_t size() const {
+            return azimuths * elevations.size();
+        }
+
+        float azimuth(std::size_t direction) const {
+            return 360.0f * static_cast<float>(direction % azimuths) / static_cast<float>(azimuths);
+        }
+
+        float elevation(std::size_t direction) const {
+            return elevations[direction / azimuths];
+        }
+    };
+
+}
+
+struct SrpPhat::Pimpl {
+
+    Pimpl(std::int32_t sample_rate, std::size_t frames_per_channel, const ArrayGeometry& microphones,
+          float sound_speed) :
+        sample_rate_(sample_rate),
+        frames_per_channel_(frames_per_channel),
+        sound_speed_(sound_speed),
+        microphones_(microphones) {
+
+        if (microphones_.size() < 2 || microphones_.size() > AudioBufferView::MaximumChannels) {
+            throw std::invalid_argument("Expected between 2 and " + std::to_string(AudioBufferView::MaximumChannels)
+                                        + " microphones.");
+        }
+
+        gcc_ = std::make_unique<GccPhat>(static_cast<std::int8_t>(microphones_.size()), frames_per_channel_);
+        for (auto i = 0ul; i < microphones_.size(); ++i) {
+            for (auto j = i + 1; j < microphones_.size(); ++j) {
+                pairs_.emplace_back(i, j);
+            }
+        }
+
+        // One extra sample per row, a copy of the lag 0, avoids wrapping around when interpolating lag -1.
+        correlations_.resize(static_cast<Eigen::Index>(pairs_.size()), static_cast<Eigen::Index>(gcc_->fftSize() + 1));
+        rebuild();
+    }
+
+    void rebuild() {
+        build(coarse_, coarse_step_);
+        build(fine_, fine_step_);
+    }
+
+    void build(Grid& grid, float step) {
+        grid.azimuths = static_cast<std::size_t>(std::ceil(360.0f / step - 1e-3f));
+        grid.elevations.clear();
+        for (auto elevation = minimum_elevation_; elevation <= maximum_elevation_ + 1e-3f; elevation += step) {
+            grid.elevations.push_back(elevation);
+        }
+
+        const auto directions = static_cast<Eigen::Index>(grid.size());
+        const auto pairs = static_cast<Eigen::Index>(pairs_.size());
+        const auto fft_size = static_cast<std::int32_t>(gcc_->fftSize());
+        grid.index.resize(pairs, directions);
+        grid.fraction.resize(pairs, directions);
+        grid.power.assign(grid.size(), 0.0f);
+
+        const auto arrivals = microphones_.arrivalDelays(ArrayGeometry::AzimuthGrid(step), grid.elevations,
+                                                         sound_speed_);
+        for (auto d = 0; d < directions; ++d) {
+            for (auto p = 0; p < pairs; ++p) {
+                // Channel i is delayed with respect to j by the difference of their times of arrival.
+                const auto i = static_cast<Eigen::Index>(pairs_[p].first);
+                const auto j = static_cast<Eigen::Index>(pairs_[p].second);
+                const auto lag = static_cast<double>(arrivals(d, i) - arrivals(d, j)) * sample_rate_;
+                const auto floor = std::floor(lag);
+                grid.index(p, d) = (static_cast<std::int32_t>(floor) % fft_size + fft_size) % fft_size;
+                grid.fraction(p, d) = static_cast<float>(lag - floor);
+            }
+        }
+    }
+
+    void accumulate(Grid& grid, std::size_t begin, std::size_t end) {
+        auto* power = grid.power.data();
+        std::fill(power + begin, power + end, 0.0f);
+        for (auto p = 0; p < correlations_.rows(); ++p) {
+            const auto* correlation = correlations_.row(p).data();
+            const auto* index = grid.index.row(p).data();
+            const auto* fraction = grid.fraction.row(p).data();
+            for (auto d = begin; d < end; ++d) {
+                const auto lower = correlation[index[d]];
+                const auto upper = correlation[index[d] + 1];
+                power[d] += lower + fraction[d] * (upper - lower);
+            }
+        }
+    }
+
+    Direction process(const AudioBufferView& input) {
+        if (input.sampleRate() != sample_rate_) {
+            throw std::invalid_argument("Discrepancy in sampling rate. Expected "
+                                        + std::to_string(sample_rate_) + " Hz");
+        }
+
+        gcc_->analyze(input);
+        const auto fft_size = static_cast<Eigen::Index>(gcc_->fftSize());
+        for (auto p = 0ul; p < pairs_.size(); ++p) {
+            gcc_->correlate(pairs_[p].first, pairs_[p].second, 0);
+            auto* row = correlations_.row(static_cast<Eigen::Index>(p)).data();
+            std::copy(gcc_->correlation(), gcc_->correlation() + fft_size, row);
+            row[fft_size] = row[0];
+        }
+
+        accumulate(coarse_, 0, coarse_.size());
+        const auto best = static_cast<std::size_t>(std::distance(coarse_.power.begin(),
+                std::max_element(coarse_.power.begin(), coarse_.power.end())));
+        if (fine_step_ == coarse_step_) {
+            return Direction{coarse_.azimuth(best), coarse_.elevation(best), coarse_.power[best] / pairs_.size()};
+        }
+
+        // Refines the search around the best coarse direction, up to one coarse step in every axis.
+        const auto azimuth = coarse_.azimuth(best);
+        const auto elevation = coarse_.elevation(best);
+        const auto center = static_cast<std::int64_t>(std::lround(azimuth * fine_.azimuths / 360.0f));
+        const auto width = static_cast<std::int64_t>(std::ceil(static_cast<float>(fine_.azimuths)
+                                                                / static_cast<float>(coarse_.azimuths)));
+        const auto azimuths = static_cast<std::int64_t>(fine_.azimuths);
+
+        auto result = Direction{azimuth, elevation, -std::numeric_limits<float>::max()};
+        for (auto e = 0ul; e < fine_.elevations.size(); ++e) {
+            if (std::abs(fine_.elevations[e] - elevation) > coarse_step_) {
+                continue;
+            }
+
+            const auto offset = e * fine_.azimuths;
+            const auto search = [&](std::size_t begin, std::size_t end) {
+                accumulate(fine_, offset + begin, offset + end);
+                for (auto d = offset + begin; d < offset + end; ++d) {
+                    if (fine_.power[d] > result.power) {
+                        result = Direction{fine_.azimuth(d), fine_.elevation(d), fine_.power[d]};
+                    }
+                }
+            };
+
+            if (2 * width + 1 >= azimuths) {
+                search(0, fine_.azimuths);
+                continue;
+            }
+
+            const auto begin = ((center - width) % azimuths + azimuths) % azimuths;
+            const auto end = ((center + width) % azimuths + azimuths) % azimuths + 1;
+            if (begin < end) {
+                search(static_cast<std::size_t>(begin), static_cast<std::size_t>(end));
+            } else {
+                search(static_cast<std::size_t>(begin), fine_.azimuths);
+                search(0, static_cast<std::size_t>(end));
+            }
+        }
+
+        result.power /= pairs_.size();
+        return result;
+    }
+
+    std::int32_t sample_rate_;
+    std::size_t frames_per_channel_;
+    float sound_speed_;
+    float coarse_step_{10.0f};
+    float fine_step_{1.0f};
+    float minimum_elevation_{0.0f};
+    float maximum_elevation_{0.0f};
+    ArrayGeometry microphones_;
+    std::vector<std::pair<std::size_t, std::size_t>> pairs_{};
+    std::unique_ptr<GccPhat> gcc_{nullptr};
+    Matrix<float> correlations_{};
+    Grid coarse_{};
+    Grid fine_{};
+};
+
+score::SrpPhat::SrpPhat(std::int32_t sample_rate, std::size_t frames_per_channel,
+        const ArrayGeometry &microphones, float sound_speed) :
+    pimpl_(std::make_unique<Pimpl>(sample_rate, frames_per_channel, microphones, sound_speed)) {
+
+}
+
+score::SrpPhat::~SrpPhat() = default;
+
+void score::SrpPhat::setResolution(float coarse, float fine) {
+    if (coarse <= 0 || fine <= 0 || fine > coarse) {
+        throw std::invalid_argument("Expected positive steps, with the fine step smaller than the coarse one.");
+    }
+    pimpl_->coarse_step_ = coarse;
+    pimpl_->fine_step_ = fine;
+    pimpl_->rebuild();
+}
+
+void score::SrpPhat::setElevationRange(float minimum, float maximum) {
+    if (minimum < -90 || maximum > 90 || minimum > maximum) {
+        throw std::invalid_argument("Expected an elevation range included in [-90, 90].");
+    }
+    pimpl_->minimum_elevation_ = minimum;
+    pimpl_->maximum_elevation_ = maximum;
+    pimpl_->rebuild();
+}
+
+std::size_t score::SrpPhat::coarseDirections() const {
+    return pimpl_->coarse_.size();
+}
+
+std::size_t score::SrpPhat::fineDirections() const {
+    return pimpl_->fine_.size();
+}
+
+const Vector<float> &score::SrpPhat::coarsePower() const {
+    return pimpl_->coarse_.power;
+}
+
+SrpPhat::Direction score::SrpPhat::process(const AudioBufferView &input) {
+    return pimpl_->process(input);
+}
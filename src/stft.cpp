@@ -0,0 +1,186 @@
+#include "stft.hpp"
+#include "real_fft.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace score;
+
+namespace {
+
+    std::vector<float> makeWindow(STFT::Window window, std::size_t size) {
+        // Periodic windows, so that shifted copies add up to a constant.
+        std::vector<float> values(size, 1.0f);
+        for (auto n = 0ul; n < size; ++n) {
+            const auto phase = 2 * M_PI * static_cast<double>(n) / static_cast<double>(size);
+            switch (window) {
+                case STFT::Rectangular:
+                    break;
+                case STFT::Hann:
+                    values[n] = static_cast<float>(0.5 - 0.5 * std::cos(phase));
+                    break;
+                case STFT::SqrtHann:
+                    values[n] = static_cast<float>(std::sqrt(0.5 - 0.5 * std::cos(phase)));
+                    break;
+                case STFT::Hamming:
+                    values[n] = static_cast<float>(0.54 - 0.46 * std::cos(phase));
+                    break;
+            }
+        }
+        return values;
+    }
+
+}
+
+struct STFT::Pimpl {
+
+    Pimpl(std::int8_t channels, std::size_t frame_size, std::size_t hop_size, std::size_t fft_size, Window window) :
+        channels_(channels),
+        frame_size_(frame_size),
+        hop_size_(hop_size),
+        fft_(fft_size == 0 ? frame_size : fft_size),
+        analysis_(makeWindow(window, frame_size)),
+        synthesis_(frame_size),
+        frame_(fft_.size(), 0.0f) {
+
+        if (channels_ <= 0 || frame_size_ == 0 || hop_size_ == 0 || hop_size_ > frame_size_
+            || fft_.size() < frame_size_) {
+            throw std::invalid_argument("Expected a positive number of channels and 0 < hop <= frame <= fft.");
+        }
+
+        // w_s(n) = w_a(n) / sum_k w_a^2(n + k * hop), so that sum_k w_a(n + k * hop) w_s(n + k * hop) = 1.
+        for (auto n = 0ul; n < frame_size_; ++n) {
+            auto energy = 0.0;
+            for (auto k = n % hop_size_; k < frame_size_; k += hop_size_) {
+                energy += analysis_[k] * analysis_[k];
+            }
+            if (energy <= 0) {
+                throw std::invalid_argument("The analysis window does not overlap with the given hop size.");
+            }
+            synthesis_[n] = static_cast<float>(analysis_[n] / energy);
+        }
+
+        const auto rows = static_cast<Eigen::Index>(channels_);
+        history_.setZero(rows, static_cast<Eigen::Index>(frame_size_));
+        overlap_.setZero(rows, static_cast<Eigen::Index>(frame_size_));
+        spectra_.setZero(rows, static_cast<Eigen::Index>(fft_.bins()));
+    }
+
+    const Matrix<std::complex<float>>& analyze(const AudioBufferView& input) {
+        if (input.channels() != channels_ || input.framesPerChannel() != hop_size_) {
+            throw std::invalid_argument("The STFT is configured to work with " + std::to_string(channels_)
+                                        + " channels and " + std::to_string(hop_size_) + " samples per channel.");
+        }
+
+        sample_rate_ = input.sampleRate();
+        const auto kept = frame_size_ - hop_size_;
+        for (auto i = 0; i < channels_; ++i) {
+            auto* history = history_.row(i).data();
+            std::copy(history + hop_size_, history + frame_size_, history);
+            for (auto n = 0ul; n < hop_size_; ++n) {
+                history[kept + n] = input(static_cast<std::size_t>(i), n);
+            }
+
+            for (auto n = 0ul; n < frame_size_; ++n) {
+                frame_[n] = history[n] * analysis_[n];
+            }
+            std::fill(frame_.begin() + frame_size_, frame_.end(), 0.0f);
+            fft_.forward(frame_.data(), spectra_.row(i).data());
+        }
+        return spectra_;
+    }
+
+    void synthesize(const Matrix<std::complex<float>>& spectra, AudioBuffer& output) {
+        if (spectra.rows() > channels_ || spectra.cols() != static_cast<Eigen::Index>(fft_.bins())) {
+            throw std::invalid_argument("Expected at most " + std::to_string(channels_) + " spectra of "
+                                        + std::to_string(fft_.bins()) + " bins.");
+        }
+
+        output.setSampleRate(sample_rate_);
+        output.resize(static_cast<std::int8_t>(spectra.rows()), hop_size_);
+        const auto scale = 1.0f / static_cast<float>(fft_.size());
+        for (auto i = 0; i < spectra.rows(); ++i) {
+            fft_.inverse(spectra.row(i).data(), frame_.data());
+            auto* overlap = overlap_.row(i).data();
+            for (auto n = 0ul; n < frame_size_; ++n) {
+                overlap[n] += frame_[n] * scale * synthesis_[n];
+            }
+
+            auto* channel = output.channel(static_cast<std::size_t>(i));
+            std::copy(overlap, overlap + hop_size_, channel);
+            std::copy(overlap + hop_size_, overlap + frame_size_, overlap);
+            std::fill(overlap + frame_size_ - hop_size_, overlap + frame_size_, 0.0f);
+        }
+    }
+
+    void reset() {
+        history_.setZero();
+        overlap_.setZero();
+        spectra_.setZero();
+    }
+
+    std::int8_t channels_;
+    std::size_t frame_size_;
+    std::size_t hop_size_;
+    std::int32_t sample_rate_{0};
+    RealFFT fft_;
+    std::vector<float> analysis_;
+    std::vector<float> synthesis_;
+    std::vector<float> frame_;
+    Matrix<float> history_{};
+    Matrix<float> overlap_{};
+    Matrix<std::complex<float>> spectra_{};
+};
+
+score::STFT::STFT(std::int8_t channels, std::size_t frame_size, std::size_t hop_size, std::size_t fft_size,
+        STFT::Window window) :
+    pimpl_(std::make_unique<Pimpl>(channels, frame_size, hop_size, fft_size, window)) {
+
+}
+
+score::STFT::~STFT() = default;
+
+std::int8_t score::STFT::channels() const {
+    return pimpl_->channels_;
+}
+
+std::size_t score::STFT::frameSize() const {
+    return pimpl_->frame_size_;
+}
+
+std::size_t score::STFT::hopSize() const {
+    return pimpl_->hop_size_;
+}
+
+std::size_t score::STFT::fftSize() const {
+    return pimpl_->fft_.size();
+}
+
+std::size_t score::STFT::bins() const {
+    return pimpl_->fft_.bins();
+}
+
+std::size_t score::STFT::latency() const {
+    return pimpl_->frame_size_ - pimpl_->hop_size_;
+}
+
+const Matrix<std::complex<float>> &score::STFT::analyze(const AudioBufferView &input) {
+    return pimpl_->analyze(input);
+}
+
+Matrix<std::complex<float>> &score::STFT::spectra() {
+    return pimpl_->spectra_;
+}
+
+void score::STFT::synthesize(AudioBuffer &output) {
+    pimpl_->synthesize(pimpl_->spectra_, output);
+}
+
+void score::STFT::synthesize(const Matrix<std::complex<float>> &spectra, AudioBuffer &output) {
+    pimpl_->synthesize(spectra, output);
+}
+
+void score::STFT::reset() {
+    pimpl_->reset();
+}
@@ -1,26 +1,29 @@
 #include "tdoa.hpp"
-#include <tdoa.h>
+
+#include <algorithm>
+#include <stdexcept>
 
 using namespace score;
 
 struct TDOA::Pimpl {
 
     Pimpl(std::int32_t sample_rate, std::int8_t channels, std::size_t frames_per_buffer, std::int8_t reference) :
+        margins_(channels, 20),
         sample_rate_(sample_rate),
         channels_(channels),
         reference_(reference),
-        indexes_(channels, 0),
-        tdoa_(channels, 0),
         frames_per_buffer_(frames_per_buffer),
-        margin_(20) {
+        tdoa_(channels, 0),
+        gcc_(channels, frames_per_buffer) {
 
-        if (reference_ > channels_) {
+        if (reference_ < 0 || reference_ >= channels_) {
             throw std::runtime_error("Invalid reference microphone");
         }
+        gcc_.setInterpolation(GccPhat::Parabolic);
     }
 
 
-    const Vector<float>& process(const AudioBuffer& input) {
+    const Vector<float>& process(const AudioBufferView& input) {
         if (input.sampleRate() != sample_rate_) {
             throw std::invalid_argument("Discrepancy in sampling rate. Expected "
                                         + std::to_string(sample_rate_) + " Hz");
@@ -36,12 +39,11 @@ struct TDOA::Pimpl {
                                         + std::to_string(frames_per_buffer_) + " samples per channel.");
         }
 
-
-        GccPhatTdoa(input.data(), input.channels(), frames_per_buffer_,
-                    reference_, margin_, indexes_.data());
-
-        for (auto i = 0ul; i < channels_; ++i)
-            tdoa_[i] = static_cast<float>(indexes_[i]) / static_cast<float>(sample_rate_);
+        gcc_.analyze(input);
+        for (auto i = 0ul; i < channels_; ++i) {
+            const auto delay = i == reference_ ? 0.0f : gcc_.correlate(i, reference_, margins_[i]).delay;
+            tdoa_[i] = delay / static_cast<float>(sample_rate_);
+        }
 
         return tdoa_;
     }
@@ -51,18 +53,35 @@ struct TDOA::Pimpl {
             throw std::runtime_error("Maximum allowed margin: "
             + std::to_string(frames_per_buffer_ / 2) + "(half of the frames per channels)");
         }
-        margin_ = margin;
+        std::fill(margins_.begin(), margins_.end(), margin);
     }
 
+    void setGeometry(const ArrayGeometry& geometry, float sound_speed) {
+        if (geometry.size() != static_cast<std::size_t>(channels_)) {
+            throw std::invalid_argument("Expected a geometry of " + std::to_string(channels_) + " microphones.");
+        }
+
+        // The delay of a channel can not exceed the time the sound needs to travel to the reference microphone.
+        const auto maximum = static_cast<std::int32_t>(frames_per_buffer_ / 2);
+        for (auto i = 0ul; i < margins_.size(); ++i) {
+            const auto margin = geometry.maximumDelay(i, reference_, sample_rate_, sound_speed);
+            margins_[i] = std::min(maximum, margin);
+        }
+    }
+
+
+    void setInterpolation(GccPhat::Interpolation interpolation) {
+        gcc_.setInterpolation(interpolation);
+    }
 
 private:
-    std::int32_t margin_;
+    std::vector<std::int32_t> margins_;
     std::int32_t sample_rate_;
     std::int8_t channels_;
     std::int8_t reference_;
-    std::int32_t frames_per_buffer_;
-    std::vector<int> indexes_;
+    std::size_t frames_per_buffer_;
     std::vector<float> tdoa_;
+    GccPhat gcc_;
 
 };
 
@@ -73,10 +92,18 @@ score::TDOA::TDOA(std::int32_t sample_rate, std::int8_t channels, std::size_t fr
 
 score::TDOA::~TDOA() = default;
 
-const Vector<float> score::TDOA::process(const AudioBuffer &input) {
+const Vector<float> score::TDOA::process(const AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
 void score::TDOA::setMargin(std::int32_t margin) {
     pimpl_->setMargin(margin);
 }
+
+void score::TDOA::setGeometry(const ArrayGeometry &geometry, float sound_speed) {
+    pimpl_->setGeometry(geometry, sound_speed);
+}
+
+void score::TDOA::setInterpolation(GccPhat::Interpolation interpolation) {
+    pimpl_->setInterpolation(interpolation);
+}
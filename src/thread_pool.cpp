@@ -0,0 +1,128 @@
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+using namespace score;
+
+namespace {
+    thread_local bool inside_pool = false;
+}
+
+struct ThreadPool::Pimpl {
+
+    explicit Pimpl(std::size_t threads) {
+        for (auto i = 1ul; i < threads; ++i) {
+            workers_.emplace_back(&Pimpl::run, this);
+        }
+    }
+
+    ~Pimpl() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void run() {
+        inside_pool = true;
+        auto seen = 0ul;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this, seen]() { return stop_ || generation_ != seen; });
+            if (stop_) {
+                return;
+            }
+
+            seen = generation_;
+            lock.unlock();
+            work();
+            lock.lock();
+            if (--active_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+
+    void work() {
+        for (auto i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+            try {
+                task_(context_, i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+            }
+        }
+    }
+
+    void dispatch(std::size_t count, Task task, void* context) {
+        if (workers_.empty() || count <= 1 || inside_pool) {
+            for (auto i = 0ul; i < count; ++i) {
+                task(context, i);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> job(job_mutex_);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = task;
+            context_ = context;
+            count_ = count;
+            next_ = 0;
+            error_ = nullptr;
+            active_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        inside_pool = true;
+        work();
+        inside_pool = false;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this]() { return active_ == 0; });
+        if (error_) {
+            std::rethrow_exception(error_);
+        }
+    }
+
+    std::vector<std::thread> workers_{};
+    std::mutex job_mutex_{};
+    std::mutex mutex_{};
+    std::mutex error_mutex_{};
+    std::condition_variable wake_{};
+    std::condition_variable done_{};
+    Task task_{nullptr};
+    void* context_{nullptr};
+    std::size_t count_{0};
+    std::atomic<std::size_t> next_{0};
+    std::size_t active_{0};
+    std::size_t generation_{0};
+    std::exception_ptr error_{};
+    bool stop_{false};
+};
+
+score::ThreadPool::ThreadPool(std::size_t threads) :
+    pimpl_(std::make_unique<Pimpl>(threads)) {
+
+}
+
+score::ThreadPool::~ThreadPool() = default;
+
+std::size_t score::ThreadPool::size() const {
+    return pimpl_->workers_.size() + 1;
+}
+
+void score::ThreadPool::dispatch(std::size_t count, Task task, void *context) {
+    pimpl_->dispatch(count, task, context);
+}
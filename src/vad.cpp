@@ -39,7 +39,11 @@ struct VAD::Pimpl {
     }
 
 
-    bool process(const AudioBuffer &input) {
+    bool process(const AudioBufferView &input) {
+        if (!input.isContiguous()) {
+            throw std::invalid_argument("Expected a view with contiguous channels.");
+        }
+
 
         if (input.channels() != 1) {
             throw std::runtime_error("Expected a mono (single channel) input frame.");
@@ -114,7 +118,7 @@ void VAD::reset() {
     pimpl_->reset();
 }
 
-bool VAD::process(const AudioBuffer &input) {
+bool VAD::process(const AudioBufferView &input) {
     return pimpl_->process(input);
 }
 
@@ -1,5 +1,7 @@
 #include <acoustic_echo_canceller.hpp>
 #include <gtest/gtest.h>
+#include <random>
+
 using namespace score;
 
 TEST(EchoCancellationTest, Initialization) {
@@ -9,3 +11,89 @@ TEST(EchoCancellationTest, Initialization) {
     constexpr auto TailSize = 0.01 * SampleRates::SampleRate8kHz;
 
 }
+
+TEST(EchoCancellationTest, AEC3CancelsTheEchoAndEstimatesTheDelay) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t FrameSize = 320;
+    constexpr std::size_t Delay = 800;
+    constexpr std::size_t Frames = 500;
+    std::mt19937 generator(41);
+    std::normal_distribution<float> distribution(0.0f, 3000.0f);
+
+    EXPECT_THROW(AEC(44100, 1, 441, 4410, AEC::WebRTCAEC3), std::invalid_argument);
+    EXPECT_THROW(AEC(SampleRate, 1, 240, 3200, AEC::WebRTCAEC3), std::invalid_argument);
+    AEC aec(SampleRate, 2, FrameSize, 3200, AEC::WebRTCAEC3);
+    EXPECT_EQ(aec.backend(), AEC::WebRTCAEC3);
+    EXPECT_THROW(AEC(SampleRate, 2, FrameSize, 3200).delay(), std::runtime_error);
+
+    // The microphones record the far end delayed by 50 ms and attenuated, the same echo path in both channels.
+    std::vector<float> far((Frames + 3) * FrameSize);
+    std::generate(far.begin(), far.end(), [&]() { return distribution(generator); });
+    AudioBuffer played(SampleRate, 2, FrameSize), recorded(SampleRate, 2, FrameSize), output;
+    auto recorded_energy = 0.0, output_energy = 0.0;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto i = 0; i < 2; ++i) {
+            for (auto n = 0ul; n < FrameSize; ++n) {
+                const auto time = frame * FrameSize + n;
+                played.channel(i)[n] = far[time + Delay];
+                recorded.channel(i)[n] = 0.5f * far[time];
+            }
+        }
+        aec.process(recorded, played, output);
+        ASSERT_EQ(output.channels(), 2);
+        ASSERT_EQ(output.framesPerChannel(), FrameSize);
+        if (frame >= Frames - 100) {
+            for (auto n = 0ul; n < FrameSize; ++n) {
+                recorded_energy += recorded.channel(1)[n] * recorded.channel(1)[n];
+                output_energy += output.channel(1)[n] * output.channel(1)[n];
+            }
+        }
+    }
+
+    EXPECT_LT(output_energy, 0.01 * recorded_energy);
+    EXPECT_NEAR(aec.delay(1), 50, 12);
+    EXPECT_GT(aec.erle(0), 3.0f);
+}
+
+TEST(EchoCancellationTest, SharesTheReferenceBetweenMicrophones) {
+    constexpr std::int32_t SampleRate = 32000;
+    constexpr std::size_t FrameSize = 320;
+    constexpr std::size_t Frames = 50;
+    std::mt19937 generator(43);
+    std::normal_distribution<float> distribution(0.0f, 3000.0f);
+
+    EXPECT_THROW(AEC::MultiReference(SampleRate, 2, 0, FrameSize, 6400), std::invalid_argument);
+    EXPECT_THROW(AEC::MultiReference(SampleRate, 2, 2, FrameSize, 6400, AEC::WebRTCAEC3), std::invalid_argument);
+
+    // Sharing the split of the reference gives the same output as one canceller per pair of channels.
+    auto shared = AEC::MultiReference(SampleRate, 2, 1, FrameSize, 6400, AEC::WebRTCAEC3);
+    AEC paired(SampleRate, 2, FrameSize, 6400, AEC::WebRTCAEC3);
+    EXPECT_EQ(shared.references(), 1);
+    EXPECT_EQ(paired.references(), 2);
+    AudioBuffer reference(SampleRate, 1, FrameSize), references(SampleRate, 2, FrameSize);
+    AudioBuffer recorded(SampleRate, 2, FrameSize), shared_output, paired_output;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto n = 0ul; n < FrameSize; ++n) {
+            reference.channel(0)[n] = distribution(generator);
+            references.channel(0)[n] = references.channel(1)[n] = reference.channel(0)[n];
+            recorded.channel(0)[n] = 0.5f * reference.channel(0)[n] + 0.1f * distribution(generator);
+            recorded.channel(1)[n] = 0.3f * reference.channel(0)[n];
+        }
+        shared.process(recorded, reference, shared_output);
+        paired.process(recorded, references, paired_output);
+        ASSERT_EQ(shared_output.channels(), 2);
+        for (auto i = 0; i < 2; ++i) {
+            for (auto n = 0ul; n < FrameSize; ++n) {
+                ASSERT_FLOAT_EQ(shared_output.channel(i)[n], paired_output.channel(i)[n]);
+            }
+        }
+    }
+
+    // Six microphones and a stereo loudspeaker.
+    auto speex = AEC::MultiReference(16000, 6, 2, 160, 1600);
+    AudioBuffer microphones(16000, 6, 160), loudspeaker(16000, 2, 160), output;
+    speex.process(microphones, loudspeaker, output);
+    EXPECT_EQ(output.channels(), 6);
+    EXPECT_EQ(output.framesPerChannel(), 160);
+    EXPECT_THROW(speex.process(microphones, microphones, output), std::invalid_argument);
+}
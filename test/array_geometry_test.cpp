@@ -0,0 +1,90 @@
+#include <array_geometry.hpp>
+#include <doa.hpp>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace score;
+
+TEST(ArrayGeometryTest, Presets) {
+    const auto respeaker4 = ArrayGeometry::ReSpeaker4Mic();
+    ASSERT_EQ(respeaker4.size(), 4);
+    EXPECT_NEAR(respeaker4.distance(0, 2), 0.08127, 1e-6);
+    EXPECT_NEAR(respeaker4.distance(1, 3), 0.08127, 1e-6);
+    EXPECT_NEAR(respeaker4.aperture(), 0.08127, 1e-6);
+
+    const auto respeaker6 = ArrayGeometry::ReSpeaker6Mic();
+    ASSERT_EQ(respeaker6.size(), 6);
+    EXPECT_NEAR(respeaker6.distance(0, 3), 0.09218, 1e-6);
+    EXPECT_NEAR(respeaker6.distance(0, 1), 0.09218 / 2, 1e-6);
+
+    const auto linear = ArrayGeometry::Linear(4, 0.05);
+    ASSERT_EQ(linear.size(), 4);
+    EXPECT_NEAR(linear[0][0], -0.075, 1e-6);
+    EXPECT_NEAR(linear[3][0], 0.075, 1e-6);
+    EXPECT_NEAR(linear.aperture(), 0.15, 1e-6);
+    EXPECT_EQ(linear.maximumDelay(0, 3, 16000, 343.2f), 7);
+
+    EXPECT_THROW(ArrayGeometry(std::vector<Point<float>>{}), std::invalid_argument);
+}
+
+TEST(ArrayGeometryTest, ArrivalDelays) {
+    const auto linear = ArrayGeometry::Linear(2, 0.1);
+    const auto azimuths = ArrayGeometry::AzimuthGrid(90);
+    ASSERT_EQ(azimuths.size(), 4);
+    EXPECT_FLOAT_EQ(azimuths[1], 90);
+
+    const auto delays = linear.arrivalDelays(azimuths, {0, 90}, 340);
+    ASSERT_EQ(delays.rows(), 8);
+    ASSERT_EQ(delays.cols(), 2);
+
+    // A source in the direction of the X axis arrives first to the microphone in the positive side.
+    EXPECT_NEAR(delays(0, 0), 0.05 / 340, 1e-7);
+    EXPECT_NEAR(delays(0, 1), -0.05 / 340, 1e-7);
+    // Broadside and vertical sources arrive at the same time to both microphones.
+    for (const auto row : {1, 3, 4, 5, 6, 7}) {
+        EXPECT_NEAR(delays(row, 0), delays(row, 1), 1e-7) << "Row: " << row;
+    }
+}
+
+TEST(ArrayGeometryTest, DOALocalizesSourceWithTheGeometry) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t SamplesPerChannel = 1024;
+    constexpr auto SoundSpeed = 343.2f;
+    constexpr auto Taps = 32;
+
+    const auto geometry = ArrayGeometry::ReSpeaker6Mic();
+    DOA doa(SampleRate, geometry, SoundSpeed);
+    doa.setGroupMicrophones(DOA::AllPairs(static_cast<std::uint8_t>(geometry.size())));
+
+    std::mt19937 generator(5);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> noise(SamplesPerChannel + 4 * Taps);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    for (const auto azimuth : {0.0f, 75.0f, 160.0f, 290.0f}) {
+        // Far-field source simulated by delaying the noise with a windowed sinc interpolator.
+        AudioBuffer input(SampleRate, static_cast<std::int8_t>(geometry.size()), SamplesPerChannel);
+        const auto az = azimuth * M_PI / 180.0;
+        for (auto m = 0ul; m < geometry.size(); ++m) {
+            const auto advance = (geometry[m][0] * std::cos(az) + geometry[m][1] * std::sin(az))
+                                 * SampleRate / SoundSpeed;
+            for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+                const auto position = static_cast<double>(n + 2 * Taps) + advance;
+                const auto base = static_cast<long>(std::floor(position));
+                auto sample = 0.0;
+                for (auto k = base - Taps + 1; k <= base + Taps; ++k) {
+                    const auto x = position - k;
+                    const auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                    sample += noise[k] * sinc * (0.5 + 0.5 * std::cos(M_PI * x / Taps));
+                }
+                input.channel(m)[n] = static_cast<float>(sample);
+            }
+        }
+
+        const auto estimated = doa.process(input);
+        const auto error = std::fmod(std::abs(estimated - azimuth), 360.0f);
+        EXPECT_LE(std::min(error, 360.0f - error), 5.0f) << "Azimuth: " << azimuth;
+    }
+}
@@ -82,3 +82,48 @@ TEST(TestInputAudioFile, UpdateFromRawData) {
     buffer.toInterleave(restored.data());
     EXPECT_TRUE(std::equal(std::begin(temporal), std::end(temporal), std::begin(restored)));
 }
+
+TEST(TestingAudioBufferView, WrapsAudioBuffer) {
+    AudioBuffer buffer(SampleRate, Stereo, NumberFrames);
+    buffer.setTimestamp(1.5);
+    AudioBufferView view(buffer);
+    EXPECT_EQ(view.sampleRate(), SampleRate);
+    EXPECT_EQ(view.channels(), Stereo);
+    EXPECT_EQ(view.framesPerChannel(), NumberFrames);
+    EXPECT_EQ(view.timestamp(), 1.5);
+    EXPECT_TRUE(view.isContiguous());
+    for (auto i = 0ul; i < Stereo; ++i) {
+        EXPECT_EQ(view.channel(i), buffer.channel(i));
+    }
+}
+
+TEST(TestingAudioBufferView, WrapsInterleavedData) {
+    std::array<float, Stereo * NumberFrames> temporal{}, restored{};
+    std::iota(std::begin(temporal), std::end(temporal), 0);
+
+    auto view = AudioBufferView::FromInterleave(SampleRate, Stereo, NumberFrames, temporal.data());
+    EXPECT_FALSE(view.isContiguous());
+    EXPECT_TRUE(view.isInterleaved());
+    EXPECT_EQ(view.stride(), Stereo);
+    EXPECT_EQ(view(1, 3), temporal[3 * Stereo + 1]);
+
+    AudioBuffer buffer;
+    view.copyTo(buffer);
+    AudioBuffer expected(SampleRate, Stereo, NumberFrames, temporal.data());
+    for (auto i = 0ul; i < Stereo; ++i) {
+        EXPECT_TRUE(std::equal(expected.channel(i), expected.channel(i) + NumberFrames, buffer.channel(i)));
+    }
+
+    view.toInterleave(restored.data());
+    EXPECT_TRUE(std::equal(std::begin(temporal), std::end(temporal), std::begin(restored)));
+}
+
+TEST(TestingAudioBufferView, SelectChannels) {
+    constexpr auto Channels = 4u;
+    AudioBuffer buffer(SampleRate, Channels, NumberFrames);
+    const auto view = AudioBufferView(buffer).select({3, 1});
+    EXPECT_EQ(view.channels(), 2);
+    EXPECT_EQ(view.channel(0), buffer.channel(3));
+    EXPECT_EQ(view.channel(1), buffer.channel(1));
+    EXPECT_THROW(AudioBufferView(buffer).select({Channels}), std::invalid_argument);
+}
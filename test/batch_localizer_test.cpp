@@ -0,0 +1,62 @@
+#include <batch_localizer.hpp>
+#include <audio_buffer.hpp>
+#include <doa.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace score;
+
+TEST(BatchLocalizerTest, MatchesSequentialDOA) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t SamplesPerFrame = 256;
+    constexpr std::size_t Frames = 150;
+    const std::vector<int> delays = {0, 1, 2, 1, 0, -1};
+    const auto geometry = ArrayGeometry::ReSpeaker6Mic();
+
+    // Incomplete frames at the end of the recording are discarded.
+    std::mt19937 generator(13);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> noise(Frames * SamplesPerFrame + 100 + 8);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+    AudioBuffer recording(SampleRate, static_cast<std::int8_t>(delays.size()), Frames * SamplesPerFrame + 100);
+    for (auto i = 0ul; i < delays.size(); ++i) {
+        for (auto j = 0ul; j < recording.framesPerChannel(); ++j) {
+            recording.channel(i)[j] = noise[4 + j - delays[i]];
+        }
+    }
+    recording.setTimestamp(2.0);
+
+    DOA doa(SampleRate, geometry);
+    doa.setGroupMicrophones(DOA::AllPairs(static_cast<std::uint8_t>(geometry.size())));
+
+    BatchLocalizer batch(SampleRate, geometry, SamplesPerFrame);
+    batch.setChunkSize(7);
+    batch.setThreadPool(std::make_shared<ThreadPool>(4));
+    const auto& results = batch.process(recording);
+    ASSERT_EQ(results.frames(), Frames);
+    ASSERT_EQ(results.delays.rows(), Frames);
+    ASSERT_EQ(results.delays.cols(), 15);
+
+    for (auto f = 0ul; f < Frames; ++f) {
+        float* channels[6];
+        for (auto i = 0ul; i < delays.size(); ++i) {
+            channels[i] = recording.channel(i) + f * SamplesPerFrame;
+        }
+        const AudioBufferView frame(SampleRate, static_cast<std::int8_t>(delays.size()), SamplesPerFrame, channels);
+        EXPECT_FLOAT_EQ(results.azimuth[f], doa.process(frame)) << "Frame: " << f;
+        EXPECT_FLOAT_EQ(results.confidence[f], doa.confidence()) << "Frame: " << f;
+        EXPECT_DOUBLE_EQ(results.time[f], 2.0 + static_cast<double>(f * SamplesPerFrame) / SampleRate);
+        for (auto p = 0ul; p < doa.delays().size(); ++p) {
+            EXPECT_FLOAT_EQ(results.delays(f, p), doa.delays()[p]);
+        }
+    }
+    EXPECT_GT(results.confidence.front(), 0.5f);
+
+    // Results are appended until reset.
+    batch.process(recording);
+    EXPECT_EQ(batch.results().frames(), 2 * Frames);
+    EXPECT_THROW(batch.setGroupMicrophones({{0, 3}}), std::runtime_error);
+    batch.reset();
+    EXPECT_EQ(batch.results().frames(), 0);
+}
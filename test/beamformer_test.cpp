@@ -0,0 +1,313 @@
+#include <beamformer.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::size_t SamplesPerChannel = 256;
+constexpr std::int8_t Channels = 4;
+
+// Frame of a stream where channel i receives the signal delayed by delays[i] samples, plus uncorrelated noise.
+static AudioBuffer MakeFrame(const std::vector<float>& signal, const std::vector<int>& delays, std::size_t frame,
+                             std::mt19937& generator, float noise) {
+    std::normal_distribution<float> distribution(0.0f, noise);
+    AudioBuffer buffer(SampleRate, Channels, SamplesPerChannel);
+    for (auto i = 0; i < Channels; ++i) {
+        for (auto j = 0ul; j < SamplesPerChannel; ++j) {
+            buffer.channel(i)[j] = signal[16 + frame * SamplesPerChannel + j - delays[i]] + distribution(generator);
+        }
+    }
+    return buffer;
+}
+
+static double Energy(const AudioBuffer& buffer) {
+    auto energy = 0.0;
+    for (auto i = 0ul; i < buffer.framesPerChannel(); ++i) {
+        energy += buffer.data()[i] * buffer.data()[i];
+    }
+    return energy;
+}
+
+TEST(BeamformerTest, MVDRCancelsInterference) {
+    constexpr std::size_t Frames = 300;
+    std::mt19937 generator(17);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> interference((Frames + 1) * SamplesPerChannel);
+    std::generate(interference.begin(), interference.end(), [&]() { return distribution(generator); });
+    const std::vector<int> delays = {0, 3, -2, 5};
+
+    Beamformer mvdr(SampleRate, Channels, SamplesPerChannel);
+    mvdr.setMethod(Beamformer::MVDR);
+    mvdr.ignoreTimeDelays(true);
+    Beamformer sum(SampleRate, Channels, SamplesPerChannel);
+    sum.ignoreTimeDelays(true);
+
+    // The noise covariance is only learnt in noise frames.
+    AudioBuffer output;
+    for (auto frame = 0ul; frame < Frames - 20; ++frame) {
+        auto input = MakeFrame(interference, delays, frame, generator, 0.01f);
+        input.setType(FrameType::Noise);
+        mvdr.process(input, output);
+    }
+
+    auto mvdr_energy = 0.0, sum_energy = 0.0;
+    for (auto frame = Frames - 20; frame < Frames; ++frame) {
+        auto input = MakeFrame(interference, delays, frame, generator, 0.01f);
+        input.setType(FrameType::Voice);
+        mvdr.process(input, output);
+        mvdr_energy += Energy(output);
+        sum.process(input, output);
+        sum_energy += Energy(output);
+    }
+    EXPECT_LT(mvdr_energy, 0.15 * sum_energy);
+}
+
+TEST(BeamformerTest, MVDRIsDistortionless) {
+    constexpr std::size_t Frames = 50;
+    std::mt19937 generator(19);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> target((Frames + 1) * SamplesPerChannel);
+    std::generate(target.begin(), target.end(), [&]() { return distribution(generator); });
+
+    Beamformer mvdr(SampleRate, Channels, SamplesPerChannel);
+    mvdr.setMethod(Beamformer::MVDR);
+    mvdr.ignoreTimeDelays(true);
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        auto noise = MakeFrame(target, {0, 0, 0, 0}, frame, generator, 1.0f);
+        for (auto i = 0ul; i < noise.size(); ++i) {
+            noise.data()[i] -= target[16 + frame * SamplesPerChannel + i % SamplesPerChannel];
+        }
+        noise.setType(FrameType::Noise);
+        AudioBuffer output;
+        mvdr.process(noise, output);
+    }
+
+    // The target, in the look direction, goes through with unit gain and a delay of one frame, once the overlap
+    // of the noise is flushed.
+    AudioBuffer output, previous;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        auto input = MakeFrame(target, {0, 0, 0, 0}, frame, generator, 0.0f);
+        input.setType(FrameType::Voice);
+        mvdr.process(input, output);
+        if (frame > 2) {
+            for (auto i = 0ul; i < SamplesPerChannel; ++i) {
+                ASSERT_NEAR(output.data()[i], previous.channel(0)[i], 1e-3) << "Frame: " << frame;
+            }
+        }
+        previous = input;
+    }
+
+    EXPECT_THROW(mvdr.setForgettingFactor(1.0f), std::invalid_argument);
+}
+
+TEST(BeamformerTest, GSCCancelsInterference) {
+    constexpr std::size_t Frames = 300;
+    std::mt19937 generator(23);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> interference((Frames + 1) * SamplesPerChannel);
+    std::generate(interference.begin(), interference.end(), [&]() { return distribution(generator); });
+    const std::vector<int> delays = {0, 3, -2, 5};
+
+    Beamformer gsc(SampleRate, Channels, SamplesPerChannel);
+    gsc.setMethod(Beamformer::GSC);
+    gsc.ignoreTimeDelays(true);
+    Beamformer sum(SampleRate, Channels, SamplesPerChannel);
+    sum.ignoreTimeDelays(true);
+
+    // The interference canceller is only adapted in frames without voice.
+    AudioBuffer output;
+    for (auto frame = 0ul; frame < Frames - 20; ++frame) {
+        auto input = MakeFrame(interference, delays, frame, generator, 0.01f);
+        input.setType(FrameType::Noise);
+        gsc.process(input, output);
+        ASSERT_EQ(output.framesPerChannel(), SamplesPerChannel);
+    }
+
+    auto gsc_energy = 0.0, sum_energy = 0.0;
+    for (auto frame = Frames - 20; frame < Frames; ++frame) {
+        auto input = MakeFrame(interference, delays, frame, generator, 0.01f);
+        input.setType(FrameType::Voice);
+        gsc.process(input, output);
+        gsc_energy += Energy(output);
+        sum.process(input, output);
+        sum_energy += Energy(output);
+    }
+    EXPECT_LT(gsc_energy, 0.15 * sum_energy);
+}
+
+TEST(BeamformerTest, GSCIsDistortionless) {
+    constexpr std::size_t Frames = 20;
+    std::mt19937 generator(31);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> target((Frames + 1) * SamplesPerChannel);
+    std::generate(target.begin(), target.end(), [&]() { return distribution(generator); });
+
+    // The blocking matrix removes the target, whatever the canceller has learnt.
+    Beamformer gsc(SampleRate, Channels, SamplesPerChannel, 0.5f);
+    gsc.setMethod(Beamformer::GSC);
+    gsc.ignoreTimeDelays(true);
+    AudioBuffer output, previous;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        auto input = MakeFrame(target, {0, 0, 0, 0}, frame, generator, 0.0f);
+        gsc.process(input, output);
+        if (frame > 0) {
+            for (auto i = 0ul; i < SamplesPerChannel; ++i) {
+                ASSERT_NEAR(output.data()[i], previous.channel(0)[i], 1e-3) << "Frame: " << frame;
+            }
+        }
+        previous = input;
+    }
+}
+
+TEST(BeamformerTest, FractionalDelayAndSumSteersToAnExplicitDirection) {
+    constexpr std::int32_t Rate = 48000;
+    constexpr std::size_t Samples = 480;
+    constexpr std::size_t Frames = 20;
+    const auto geometry = ArrayGeometry::Linear(4, 0.05);
+    const auto arrivals = geometry.arrivalDelays({60.0f}, {0.0f}, 343.2f);
+
+    // Sum of tones, so every channel can be delayed by a fraction of a sample.
+    const std::vector<double> frequencies = {440.0, 1250.0, 2730.0, 5100.0};
+    const auto source = [&](double time) {
+        auto value = 0.0;
+        for (auto k = 0ul; k < frequencies.size(); ++k) {
+            value += std::sin(2 * M_PI * frequencies[k] * time + static_cast<double>(k));
+        }
+        return static_cast<float>(value / frequencies.size());
+    };
+
+    Beamformer fractional(Rate, 4, Samples);
+    fractional.setMethod(Beamformer::FractionalDelayAndSum);
+    fractional.setGeometry(geometry);
+    EXPECT_THROW(Beamformer(Rate, 4, Samples).steer(60.0f), std::runtime_error);
+    fractional.steer(60.0f);
+    EXPECT_TRUE(fractional.isSteered());
+
+    // Every channel is aligned with the first one, delayed by one frame.
+    AudioBuffer input(Rate, 4, Samples), output;
+    auto error = 0.0, energy = 0.0;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto m = 0; m < 4; ++m) {
+            for (auto n = 0ul; n < Samples; ++n) {
+                const auto time = static_cast<double>(frame * Samples + n) / Rate;
+                input.channel(m)[n] = source(time - arrivals(0, m));
+            }
+        }
+        fractional.process(input, output);
+        ASSERT_EQ(output.framesPerChannel(), Samples);
+        if (frame > 1) {
+            for (auto n = 0ul; n < Samples; ++n) {
+                const auto time = static_cast<double>((frame - 1) * Samples + n) / Rate;
+                const auto expected = source(time - arrivals(0, 0));
+                error += std::pow(output.data()[n] - expected, 2);
+                energy += std::pow(expected, 2);
+            }
+        }
+    }
+    EXPECT_LT(error, 1e-3 * energy);
+}
+
+TEST(BeamformerTest, FractionalDelayAndSumTracksFractionalDelays) {
+    constexpr std::size_t Frames = 20;
+    constexpr auto Taps = 32;
+    const std::vector<double> delays = {0.0, 1.5, -2.25, 3.75};
+    std::mt19937 generator(41);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> noise((Frames + 1) * SamplesPerChannel + 2 * Taps);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    // Band-limited source delayed by a fraction of a sample with a Hann windowed sinc.
+    const auto source = [&](double position) {
+        const auto base = static_cast<long>(std::floor(position));
+        auto sample = 0.0;
+        for (auto k = base - Taps + 1; k <= base + Taps; ++k) {
+            const auto x = position - k;
+            const auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+            sample += noise[static_cast<std::size_t>(k)] * sinc * (0.5 + 0.5 * std::cos(M_PI * x / Taps));
+        }
+        return static_cast<float>(sample);
+    };
+
+    // The delays are estimated in every frame, without steering the beam.
+    Beamformer fractional(SampleRate, Channels, SamplesPerChannel);
+    fractional.setMethod(Beamformer::FractionalDelayAndSum);
+    AudioBuffer input(SampleRate, Channels, SamplesPerChannel), output;
+    auto error = 0.0, energy = 0.0;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto m = 0; m < Channels; ++m) {
+            for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+                input.channel(m)[n] = source(Taps + static_cast<double>(frame * SamplesPerChannel + n) - delays[m]);
+            }
+        }
+        fractional.process(input, output);
+        ASSERT_FALSE(fractional.isSteered());
+        if (frame > 1) {
+            for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+                const auto expected = source(Taps + static_cast<double>((frame - 1) * SamplesPerChannel + n));
+                error += std::pow(output.data()[n] - expected, 2);
+                energy += std::pow(expected, 2);
+            }
+        }
+    }
+    EXPECT_LT(error, 1e-2 * energy);
+}
+
+TEST(BeamformerTest, BeamBankSelectsTheBeamOfTheSource) {
+    constexpr std::size_t Frames = 10;
+    const auto geometry = ArrayGeometry::ReSpeaker6Mic();
+    const auto arrivals = geometry.arrivalDelays({120.0f}, {0.0f}, 343.2f);
+    std::mt19937 generator(37);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+
+    Beamformer bank(SampleRate, 6, SamplesPerChannel);
+    bank.setMethod(Beamformer::BeamBank);
+    AudioBuffer input(SampleRate, 6, SamplesPerChannel), output;
+    EXPECT_THROW(bank.setBeams({0.0f, 60.0f}), std::runtime_error);
+    bank.setGeometry(geometry);
+    EXPECT_THROW(bank.process(input, output), std::runtime_error);
+    bank.setBeams({0.0f, 60.0f, 120.0f, 180.0f, 240.0f, 300.0f});
+    EXPECT_EQ(bank.beams(), 6);
+
+    Beamformer all(SampleRate, 6, SamplesPerChannel);
+    all.setMethod(Beamformer::BeamBank);
+    all.setGeometry(geometry);
+    all.setBeams({0.0f, 60.0f, 120.0f, 180.0f, 240.0f, 300.0f});
+    all.setBeamSelection(Beamformer::AllBeams);
+
+    Beamformer steered(SampleRate, 6, SamplesPerChannel);
+    steered.setMethod(Beamformer::FractionalDelayAndSum);
+    steered.setGeometry(geometry);
+    steered.steer(120.0f);
+
+    // A tone from 120 degrees, plus uncorrelated noise in every microphone.
+    AudioBuffer beams, reference;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto m = 0; m < 6; ++m) {
+            for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+                const auto time = static_cast<double>(frame * SamplesPerChannel + n) / SampleRate - arrivals(0, m);
+                input.channel(m)[n] = static_cast<float>(std::sin(2 * M_PI * 3000 * time))
+                                      + 0.1f * distribution(generator);
+            }
+        }
+        bank.process(input, output);
+        all.process(input, beams);
+        steered.process(input, reference);
+        ASSERT_EQ(output.channels(), 1);
+        ASSERT_EQ(beams.channels(), 6);
+        EXPECT_EQ(bank.selectedBeam(), 2);
+        for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+            ASSERT_NEAR(beams.channel(2)[n], reference.data()[n], 1e-4);
+            ASSERT_NEAR(output.data()[n], reference.data()[n], 1e-4);
+        }
+    }
+
+    // Frames of noise keep the previous selection.
+    for (auto i = 0ul; i < input.size(); ++i) {
+        input.data()[i] = distribution(generator);
+    }
+    input.setType(FrameType::Noise);
+    bank.process(input, output);
+    EXPECT_EQ(bank.selectedBeam(), 2);
+}
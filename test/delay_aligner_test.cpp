@@ -0,0 +1,69 @@
+#include <delay_aligner.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace score;
+
+TEST(DelayAlignerTest, AlignsThePlayedSignalWithItsEcho) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t FrameSize = 160;
+    constexpr std::size_t Delay = 1600;
+    constexpr std::size_t Frames = 500;
+    std::mt19937 generator(47);
+    std::normal_distribution<float> distribution(0.0f, 3000.0f);
+
+    EXPECT_THROW(DelayAligner(SampleRate, 0, FrameSize, 4800), std::invalid_argument);
+    EXPECT_THROW(DelayAligner(SampleRate, 1, 480, 4800), std::invalid_argument);
+    EXPECT_THROW(DelayAligner(4000, 1, 40, 4800), std::invalid_argument);
+
+    DelayAligner aligner(SampleRate, 2, FrameSize, 4800);
+    EXPECT_EQ(aligner.blockSize(), 80);
+    EXPECT_EQ(aligner.delay(), 0);
+
+    // Two microphones record the stereo far end delayed by 100 ms, with a different gain per loudspeaker.
+    std::vector<float> left((Frames + 1) * FrameSize + Delay), right(left.size());
+    std::generate(left.begin(), left.end(), [&]() { return distribution(generator); });
+    std::generate(right.begin(), right.end(), [&]() { return distribution(generator); });
+    AudioBuffer played(SampleRate, 2, FrameSize), recorded(SampleRate, 2, FrameSize), aligned;
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto n = 0ul; n < FrameSize; ++n) {
+            const auto time = frame * FrameSize + n;
+            played.channel(0)[n] = left[time + Delay];
+            played.channel(1)[n] = right[time + Delay];
+            recorded.channel(0)[n] = 0.5f * left[time] + 0.2f * right[time];
+            recorded.channel(1)[n] = 0.3f * left[time] + 0.4f * right[time];
+        }
+        aligner.process(recorded, played, aligned);
+        ASSERT_EQ(aligned.channels(), 2);
+        ASSERT_EQ(aligned.framesPerChannel(), FrameSize);
+    }
+
+    // The played signal is delayed up to one block before its echo, and its samples are not altered.
+    EXPECT_LE(aligner.delay(), Delay);
+    EXPECT_GE(aligner.delay(), Delay - 2 * aligner.blockSize());
+    EXPECT_GT(aligner.quality(), 0.0f);
+    const auto lag = Delay - aligner.delay();
+    for (auto n = 0ul; n < FrameSize; ++n) {
+        const auto time = (Frames - 1) * FrameSize + n + lag;
+        ASSERT_FLOAT_EQ(aligned.channel(0)[n], left[time]);
+        ASSERT_FLOAT_EQ(aligned.channel(1)[n], right[time]);
+    }
+
+    // The alignment follows a shorter delay, after a change of the audio devices.
+    for (auto frame = 0ul; frame < Frames; ++frame) {
+        for (auto n = 0ul; n < FrameSize; ++n) {
+            const auto time = frame * FrameSize + n;
+            played.channel(0)[n] = left[time + Delay / 2];
+            played.channel(1)[n] = right[time + Delay / 2];
+            recorded.channel(0)[n] = 0.5f * left[time] + 0.2f * right[time];
+            recorded.channel(1)[n] = 0.3f * left[time] + 0.4f * right[time];
+        }
+        aligner.process(recorded, played, aligned);
+    }
+    EXPECT_LE(aligner.delay(), Delay / 2);
+    EXPECT_GE(aligner.delay(), Delay / 2 - 2 * aligner.blockSize());
+
+    aligner.reset();
+    EXPECT_EQ(aligner.delay(), 0);
+}
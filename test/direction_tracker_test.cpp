@@ -0,0 +1,103 @@
+#include <direction_tracker.hpp>
+#include <audio_buffer.hpp>
+
+#include "testing_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace score;
+
+TEST(DirectionTrackerTest, TracksTwoMovingSources) {
+    constexpr auto Elapsed = 0.01;
+    std::mt19937 generator(7);
+    std::normal_distribution<float> noise(0.0f, 3.0f);
+
+    DirectionTracker tracker;
+    std::vector<DirectionTracker::Observation> observations(2);
+    for (auto frame = 0; frame < 300; ++frame) {
+        const auto time = static_cast<float>(frame * Elapsed);
+        // One static source and another one moving at 20 degrees/sec across 0 degrees.
+        observations[0] = {90.0f + noise(generator), 1.0f};
+        observations[1] = {std::fmod(350.0f + 20.0f * time + noise(generator), 360.0f), 1.0f};
+        tracker.update(observations, Elapsed);
+        if (frame < 2) {
+            EXPECT_TRUE(tracker.tracks().empty());
+        }
+    }
+
+    const auto& tracks = tracker.tracks();
+    ASSERT_EQ(tracks.size(), 2);
+    EXPECT_EQ(tracks[0].id, 0);
+    EXPECT_EQ(tracks[1].id, 1);
+    EXPECT_LE(AngularError(tracks[0].azimuth, 90.0f), 2.0f);
+    EXPECT_LE(AngularError(tracks[1].azimuth, 350.0f + 20.0f * 2.99f - 360.0f), 3.0f);
+    EXPECT_NEAR(tracks[1].velocity, 20.0f, 10.0f);
+    EXPECT_EQ(tracks[0].hits, 300);
+}
+
+TEST(DirectionTrackerTest, SkipsLocalizationOnNonSpeechFrames) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t SamplesPerChannel = 160;
+
+    DirectionTracker tracker;
+    tracker.setTermination(25, 1.0);
+    tracker.setLocalizer([](const AudioBufferView&, std::vector<DirectionTracker::Observation>& observations) {
+        observations.push_back({45.0f, 1.0f});
+    });
+
+    AudioBuffer frame(SampleRate, 4, SamplesPerChannel);
+    frame.setType(FrameType::Voice);
+    for (auto i = 0; i < 10; ++i) {
+        tracker.process(frame);
+    }
+    ASSERT_EQ(tracker.tracks().size(), 1);
+    EXPECT_EQ(tracker.localizations(), 10);
+
+    // The track is propagated through the silence, but the localizer is not run.
+    frame.setType(FrameType::Noise);
+    for (auto i = 0; i < 50; ++i) {
+        tracker.process(frame);
+    }
+    ASSERT_EQ(tracker.tracks().size(), 1);
+    EXPECT_NEAR(tracker.tracks().front().idle, 0.5, 1e-6);
+    EXPECT_LE(AngularError(tracker.tracks().front().azimuth, 45.0f), 1.0f);
+    EXPECT_EQ(tracker.localizations(), 10);
+
+    // An external VAD decision overrides the type of the frame.
+    tracker.process(frame, true);
+    EXPECT_EQ(tracker.localizations(), 11);
+    EXPECT_EQ(tracker.tracks().front().idle, 0);
+
+    // Without observations for longer than the timeout, the track dies.
+    for (auto i = 0; i < 100; ++i) {
+        tracker.process(frame);
+    }
+    EXPECT_TRUE(tracker.tracks().empty());
+}
+
+TEST(DirectionTrackerTest, EndsTracksAfterMisses) {
+    DirectionTracker tracker;
+    tracker.setTermination(5, 10.0);
+
+    const std::vector<DirectionTracker::Observation> source = {{200.0f, 1.0f}};
+    for (auto i = 0; i < 5; ++i) {
+        tracker.update(source, 0.01);
+    }
+    ASSERT_EQ(tracker.tracks().size(), 1);
+
+    // A speech frame without observations near the track counts as a miss, while the new source is confirmed.
+    const std::vector<DirectionTracker::Observation> other = {{20.0f, 1.0f}};
+    for (auto i = 0; i < 4; ++i) {
+        tracker.update(other, 0.01);
+        ASSERT_EQ(tracker.tracks().size(), i < 2 ? 1 : 2) << "Frame: " << i;
+    }
+    tracker.update(other, 0.01);
+    ASSERT_EQ(tracker.tracks().size(), 1);
+    EXPECT_LE(AngularError(tracker.tracks().front().azimuth, 20.0f), 1.0f);
+
+    tracker.reset();
+    EXPECT_TRUE(tracker.tracks().empty());
+    EXPECT_THROW(tracker.setMaximumTracks(0), std::invalid_argument);
+}
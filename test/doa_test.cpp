@@ -0,0 +1,48 @@
+#include <doa.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace score;
+
+TEST(DOATest, EstimatesDelaysOfAllPairs) {
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t SamplesPerChannel = 512;
+    const std::vector<int> delays = {0, 1, -1, 2};
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> noise(2 * SamplesPerChannel);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    AudioBuffer input(SampleRate, static_cast<std::int8_t>(delays.size()), SamplesPerChannel);
+    for (auto i = 0ul; i < delays.size(); ++i) {
+        for (auto j = 0ul; j < SamplesPerChannel; ++j) {
+            input.channel(i)[j] = noise[SamplesPerChannel / 2 + j - delays[i]];
+        }
+    }
+
+    DOA doa(SampleRate, static_cast<std::uint8_t>(delays.size()));
+    const auto pairs = DOA::AllPairs(static_cast<std::uint8_t>(delays.size()));
+    ASSERT_EQ(pairs.size(), 6);
+    doa.setGroupMicrophones(pairs);
+
+    // The refined delays of integer shifts are close to, but not exactly, the integer lags.
+    const auto& refined = doa.estimateDelays(input);
+    ASSERT_EQ(refined.size(), pairs.size());
+    for (auto i = 0ul; i < pairs.size(); ++i) {
+        const auto expected = delays[pairs[i].first] - delays[pairs[i].second];
+        EXPECT_NEAR(refined[i] * SampleRate, expected, 0.05) << "Pair: " << i;
+    }
+
+    doa.setInterpolation(GccPhat::None);
+    const auto& estimated = doa.estimateDelays(input);
+    ASSERT_EQ(estimated.size(), pairs.size());
+    for (auto i = 0ul; i < pairs.size(); ++i) {
+        const auto expected = delays[pairs[i].first] - delays[pairs[i].second];
+        EXPECT_NEAR(estimated[i] * SampleRate, expected, 1e-3) << "Pair: " << i;
+    }
+    EXPECT_EQ(&doa.delays(), &estimated);
+
+    EXPECT_THROW(doa.setGroupMicrophones({{0, 4}}), std::invalid_argument);
+}
@@ -0,0 +1,45 @@
+#include <frame_adapter.hpp>
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::int8_t Stereo = 2;
+
+TEST(FrameAdapterTest, ReBlocksInterleavedCapture) {
+    constexpr auto CaptureFrames = 1024ul;
+    constexpr auto Blocks = 5ul;
+    auto adapter = FrameAdapter::FromDuration(SampleRate, Stereo, 10);
+    ASSERT_EQ(adapter->framesPerChannel(), 160);
+
+    std::vector<float> expected, received;
+    std::vector<double> timestamps;
+    adapter->setOnFrameReady([&](AudioBuffer& frame) {
+        EXPECT_EQ(frame.framesPerChannel(), 160);
+        received.insert(received.end(), frame.channel(1), frame.channel(1) + frame.framesPerChannel());
+        timestamps.push_back(frame.timestamp());
+    });
+
+    std::vector<float> interleaved(Stereo * CaptureFrames);
+    for (auto block = 0ul; block < Blocks; ++block) {
+        for (auto i = 0ul; i < CaptureFrames; ++i) {
+            interleaved[Stereo * i] = 0;
+            interleaved[Stereo * i + 1] = static_cast<float>(block * CaptureFrames + i);
+            expected.push_back(interleaved[Stereo * i + 1]);
+        }
+        auto view = AudioBufferView::FromInterleave(SampleRate, Stereo, CaptureFrames, interleaved.data());
+        view.setTimestamp(static_cast<double>(block * CaptureFrames) / SampleRate);
+        adapter->process(view);
+    }
+
+    const auto frames = Blocks * CaptureFrames / 160;
+    ASSERT_EQ(timestamps.size(), frames);
+    EXPECT_EQ(adapter->pending(), Blocks * CaptureFrames - frames * 160);
+    EXPECT_TRUE(std::equal(received.begin(), received.end(), expected.begin()));
+    for (auto i = 0ul; i < frames; ++i) {
+        EXPECT_NEAR(timestamps[i], static_cast<double>(i * 160) / SampleRate, 1e-9);
+    }
+}
@@ -0,0 +1,124 @@
+#include <gcc_phat.hpp>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::size_t SamplesPerChannel = 1024;
+
+static AudioBuffer DelayedNoise(const std::vector<int>& delays, std::uint32_t seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> noise(2 * SamplesPerChannel);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    AudioBuffer buffer(SampleRate, static_cast<std::int8_t>(delays.size()), SamplesPerChannel);
+    for (auto i = 0ul; i < delays.size(); ++i) {
+        for (auto j = 0ul; j < SamplesPerChannel; ++j) {
+            buffer.channel(i)[j] = noise[SamplesPerChannel / 2 + j - delays[i]];
+        }
+    }
+    return buffer;
+}
+
+TEST(GccPhatTest, EstimatesIntegerDelays) {
+    const std::vector<int> delays = {0, 7, -12, 30};
+    const auto buffer = DelayedNoise(delays, 42);
+
+    GccPhat gcc(static_cast<std::int8_t>(delays.size()), SamplesPerChannel);
+    EXPECT_EQ(gcc.fftSize(), 2 * SamplesPerChannel);
+
+    gcc.analyze(buffer);
+    for (auto i = 1ul; i < delays.size(); ++i) {
+        const auto peak = gcc.correlate(i, 0, 40);
+        EXPECT_EQ(peak.lag, delays[i]);
+        EXPECT_GT(peak.value, 0.5f);
+        EXPECT_FLOAT_EQ(gcc.correlation()[(peak.lag + gcc.fftSize()) % gcc.fftSize()], peak.value);
+    }
+
+    EXPECT_EQ(gcc.correlate(3, 1, 40).lag, delays[3] - delays[1]);
+    EXPECT_THROW(gcc.correlate(4, 0, 40), std::invalid_argument);
+    EXPECT_THROW(gcc.correlate(1, 0, SamplesPerChannel), std::invalid_argument);
+}
+
+TEST(GccPhatTest, AnalyzesInterleavedViews) {
+    const std::vector<int> delays = {0, -5};
+    const auto buffer = DelayedNoise(delays, 7);
+    std::vector<float> interleaved(buffer.size());
+    buffer.toInterleave(interleaved.data());
+
+    GccPhat gcc(2, SamplesPerChannel);
+    gcc.analyze(AudioBufferView::FromInterleave(SampleRate, 2, SamplesPerChannel, interleaved.data()));
+    EXPECT_EQ(gcc.correlate(1, 0, 20).lag, -5);
+}
+
+TEST(GccPhatTest, RunsConcurrentInstances) {
+    constexpr auto Threads = 4;
+    std::vector<std::thread> threads;
+    std::vector<int> failures(Threads, 0);
+    for (auto t = 0; t < Threads; ++t) {
+        threads.emplace_back([t, &failures]() {
+            const std::vector<int> delays = {0, t + 1, -(t + 1)};
+            const auto buffer = DelayedNoise(delays, static_cast<std::uint32_t>(t));
+            GccPhat gcc(3, SamplesPerChannel);
+            for (auto iteration = 0; iteration < 50; ++iteration) {
+                gcc.analyze(buffer);
+                failures[t] += gcc.correlate(1, 0, 10).lag != delays[1];
+                failures[t] += gcc.correlate(2, 0, 10).lag != delays[2];
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto failure : failures) {
+        EXPECT_EQ(failure, 0);
+    }
+}
+
+TEST(GccPhatTest, RefinesFractionalDelays) {
+    constexpr auto Taps = 32;
+    const std::vector<double> delays = {0, 2.3, -1.6, 0.4};
+
+    std::mt19937 generator(5);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> noise(SamplesPerChannel + 4 * Taps);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    // Delays white noise with a windowed sinc interpolator.
+    AudioBuffer buffer(SampleRate, static_cast<std::int8_t>(delays.size()), SamplesPerChannel);
+    for (auto i = 0ul; i < delays.size(); ++i) {
+        for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+            const auto position = static_cast<double>(n + 2 * Taps) - delays[i];
+            const auto base = static_cast<long>(std::floor(position));
+            auto sample = 0.0;
+            for (auto k = base - Taps + 1; k <= base + Taps; ++k) {
+                const auto x = position - k;
+                const auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                sample += noise[k] * sinc * (0.5 + 0.5 * std::cos(M_PI * x / Taps));
+            }
+            buffer.channel(i)[n] = static_cast<float>(sample);
+        }
+    }
+
+    GccPhat gcc(static_cast<std::int8_t>(delays.size()), SamplesPerChannel);
+    gcc.analyze(buffer);
+    for (auto i = 1ul; i < delays.size(); ++i) {
+        EXPECT_EQ(gcc.correlate(i, 0, 10).delay, std::round(delays[i]));
+
+        gcc.setInterpolation(GccPhat::Parabolic);
+        EXPECT_NEAR(gcc.correlate(i, 0, 10).delay, delays[i], 0.25);
+
+        gcc.setInterpolation(GccPhat::BandLimited);
+        EXPECT_NEAR(gcc.correlate(i, 0, 10).delay, delays[i], 0.05);
+
+        gcc.setInterpolation(GccPhat::None);
+    }
+}
@@ -0,0 +1,102 @@
+#include <music.hpp>
+#include <array_geometry.hpp>
+
+#include "testing_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::size_t SamplesPerChannel = 512;
+constexpr std::size_t Frames = 30;
+constexpr float SoundSpeed = 343.2f;
+
+// Adds to the recording a far-field white noise source, delayed with a windowed sinc interpolator.
+static void AddSource(Matrix<float>& recording, const std::vector<Point<float>>& microphones, float azimuth,
+                      std::uint32_t seed) {
+    constexpr auto Taps = 32;
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> noise(static_cast<std::size_t>(recording.cols()) + 4 * Taps);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    const auto az = azimuth * M_PI / 180.0;
+    for (auto m = 0ul; m < microphones.size(); ++m) {
+        const auto advance = (microphones[m][0] * std::cos(az) + microphones[m][1] * std::sin(az))
+                             * SampleRate / SoundSpeed;
+        for (auto n = 0l; n < recording.cols(); ++n) {
+            const auto position = static_cast<double>(n + 2 * Taps) + advance;
+            const auto base = static_cast<long>(std::floor(position));
+            auto sample = 0.0;
+            for (auto k = base - Taps + 1; k <= base + Taps; ++k) {
+                const auto x = position - k;
+                const auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                sample += noise[k] * sinc * (0.5 + 0.5 * std::cos(M_PI * x / Taps));
+            }
+            recording(static_cast<Eigen::Index>(m), n) += static_cast<float>(sample);
+        }
+    }
+}
+
+static const std::vector<Music::Source>& Localize(Music& music, const Matrix<float>& recording) {
+    const auto channels = static_cast<std::int8_t>(recording.rows());
+    AudioBuffer frame(SampleRate, channels, SamplesPerChannel);
+    const std::vector<Music::Source>* sources = nullptr;
+    for (auto f = 0ul; f < Frames; ++f) {
+        for (auto m = 0; m < channels; ++m) {
+            for (auto i = 0ul; i < SamplesPerChannel; ++i) {
+                frame.channel(m)[i] = recording(m, static_cast<Eigen::Index>(f * SamplesPerChannel + i));
+            }
+        }
+        sources = &music.process(frame);
+    }
+    return *sources;
+}
+
+TEST(MusicTest, LocalizesSingleSource) {
+    const auto microphones = ArrayGeometry::Circular(6, 0.0463).microphones();
+    Matrix<float> recording = Matrix<float>::Zero(6, Frames * SamplesPerChannel);
+    AddSource(recording, microphones, 75, 1);
+
+    Music music(SampleRate, SamplesPerChannel, microphones, SoundSpeed);
+    const auto& sources = Localize(music, recording);
+    ASSERT_EQ(sources.size(), 1);
+    EXPECT_LE(AngularError(sources[0].azimuth, 75), 2.0f);
+    EXPECT_EQ(music.spectrum().size(), 360);
+}
+
+TEST(MusicTest, LocalizesTwoSources) {
+    const auto microphones = ArrayGeometry::Circular(8, 0.06).microphones();
+    Matrix<float> recording = Matrix<float>::Zero(8, Frames * SamplesPerChannel);
+    AddSource(recording, microphones, 40, 1);
+    AddSource(recording, microphones, 210, 2);
+
+    Music music(SampleRate, SamplesPerChannel, microphones, SoundSpeed);
+    music.setSources(2);
+    const auto& sources = Localize(music, recording);
+    ASSERT_EQ(sources.size(), 2);
+    const auto first = std::min(AngularError(sources[0].azimuth, 40), AngularError(sources[1].azimuth, 40));
+    const auto second = std::min(AngularError(sources[0].azimuth, 210), AngularError(sources[1].azimuth, 210));
+    EXPECT_LE(first, 3.0f);
+    EXPECT_LE(second, 3.0f);
+}
+
+TEST(MusicTest, BoundsTheDecompositions) {
+    const auto microphones = ArrayGeometry::Circular(5, 0.05).microphones();
+    Matrix<float> recording = Matrix<float>::Zero(5, Frames * SamplesPerChannel);
+    AddSource(recording, microphones, 300, 3);
+
+    Music music(SampleRate, SamplesPerChannel, microphones, SoundSpeed);
+    music.setUpdateInterval(10);
+    music.setDriftThreshold(std::numeric_limits<float>::max());
+    const auto& sources = Localize(music, recording);
+    EXPECT_EQ(music.decompositions(), 1 + (Frames - 1) / 10);
+    ASSERT_EQ(sources.size(), 1);
+    EXPECT_LE(AngularError(sources[0].azimuth, 300), 2.0f);
+
+    EXPECT_THROW(music.setSources(5), std::invalid_argument);
+    EXPECT_THROW(music.setFrequencyRange(9000, 10000), std::invalid_argument);
+}
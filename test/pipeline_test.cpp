@@ -0,0 +1,135 @@
+#include <pipeline.hpp>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::int8_t Channels = 2;
+constexpr std::size_t NumberFrames = 160;
+
+namespace {
+
+    Pipeline::Process Scale(float factor) {
+        return [factor](const AudioBufferView& input, AudioBuffer& output) {
+            output.setSampleRate(input.sampleRate());
+            output.resize(input.channels(), input.framesPerChannel());
+            for (auto i = 0ul; i < input.channels(); ++i) {
+                std::transform(input.channel(i), input.channel(i) + input.framesPerChannel(), output.channel(i),
+                        [factor](float sample) { return sample * factor; });
+            }
+        };
+    }
+
+}
+
+TEST(PipelineTest, ChainPingPongs) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    pipeline.add("first", Scale(2));
+    pipeline.add("second", Scale(3));
+    pipeline.add("third", Scale(5));
+
+    AudioBuffer result;
+    pipeline.sink("output", [&result](const AudioBufferView& input) {
+        input.copyTo(result);
+    });
+    pipeline.build();
+    EXPECT_EQ(pipeline.buffers(), 2);
+    EXPECT_THROW(pipeline.add("late", Scale(1)), std::runtime_error);
+
+    AudioBuffer input(SampleRate, Channels, NumberFrames);
+    std::fill(input.data(), input.data() + input.size(), 1.f);
+    pipeline.process(input);
+    EXPECT_TRUE(std::all_of(result.data(), result.data() + result.size(), [](float x) { return x == 30.f; }));
+}
+
+TEST(PipelineTest, InPlaceReusesParentBuffer) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    pipeline.add("first", Scale(2));
+    pipeline.add("second", Scale(3), Pipeline::Previous, Pipeline::SameFormat(), true);
+    pipeline.add("third", Scale(5), Pipeline::Previous, Pipeline::SameFormat(), true);
+    pipeline.build();
+    EXPECT_EQ(pipeline.buffers(), 1);
+}
+
+TEST(PipelineTest, FanOutKeepsBranchesAlive) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    const auto root = pipeline.add("root", Scale(2));
+    const auto left = pipeline.add("left", Scale(3), root, Pipeline::SameFormat(), true);
+    const auto mono = pipeline.add("mono", [](const AudioBufferView& input, AudioBuffer& output) {
+        output.resize(1, input.framesPerChannel());
+        std::copy(input.channel(1), input.channel(1) + input.framesPerChannel(), output.channel(0));
+    }, root, Pipeline::ChannelsFormat(1));
+
+    float left_value = 0, mono_value = 0;
+    pipeline.sink("left-sink", [&](const AudioBufferView& input) { left_value = input.channel(0)[0]; }, left);
+    pipeline.sink("mono-sink", [&](const AudioBufferView& input) { mono_value = input.channel(0)[0]; }, mono);
+    pipeline.build();
+    EXPECT_EQ(pipeline.format(mono).channels, 1);
+    EXPECT_EQ(pipeline.format(left).channels, Channels);
+
+    AudioBuffer input(SampleRate, Channels, NumberFrames);
+    std::fill(input.data(), input.data() + input.size(), 1.f);
+    pipeline.process(input);
+
+    // The in-place stage is not the last consumer of root, so the mono branch still reads the root output.
+    EXPECT_EQ(left_value, 6.f);
+    EXPECT_EQ(mono_value, 2.f);
+}
+
+TEST(PipelineTest, RejectsUnexpectedFormats) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    pipeline.add("resample", Scale(1), Pipeline::Previous, Pipeline::SampleRateFormat(2 * SampleRate));
+    pipeline.build();
+    EXPECT_EQ(pipeline.format(1).frames_per_channel, 2 * NumberFrames);
+
+    AudioBuffer input(SampleRate, Channels, NumberFrames);
+    EXPECT_THROW(pipeline.process(input), std::runtime_error);
+    EXPECT_THROW(pipeline.process(AudioBuffer(SampleRate, 1, NumberFrames)), std::invalid_argument);
+}
+
+TEST(PipelineTest, SampleRateChangeDoesNotReuseBuffer) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    pipeline.add("first", Scale(2));
+    pipeline.add("relabel", Scale(1), Pipeline::Previous, [](const Pipeline::Format& format) {
+        return Pipeline::Format{SampleRate / 2, format.channels, format.frames_per_channel};
+    }, true);
+    pipeline.build();
+    EXPECT_EQ(pipeline.buffers(), 2);
+}
+
+TEST(PipelineTest, CombinesTwoSources) {
+    Pipeline pipeline(SampleRate, Channels, NumberFrames);
+    const auto far = pipeline.source("far", SampleRate, 1, NumberFrames);
+    const auto near = pipeline.add("near", Scale(3), Pipeline::Source);
+    const auto cancel = pipeline.combine("cancel", [](const AudioBufferView& input, const AudioBufferView& reference,
+            AudioBuffer& output) {
+        output.setSampleRate(input.sampleRate());
+        output.resize(input.channels(), input.framesPerChannel());
+        for (auto i = 0ul; i < input.channels(); ++i) {
+            for (auto j = 0ul; j < input.framesPerChannel(); ++j) {
+                output.channel(i)[j] = input.channel(i)[j] - reference.channel(0)[j];
+            }
+        }
+    }, near, far);
+
+    AudioBuffer result;
+    pipeline.sink("output", [&result](const AudioBufferView& input) {
+        input.copyTo(result);
+    }, cancel);
+    pipeline.build();
+
+    AudioBuffer input(SampleRate, Channels, NumberFrames);
+    std::fill(input.data(), input.data() + input.size(), 1.f);
+    EXPECT_THROW(pipeline.process(input), std::runtime_error);
+
+    AudioBuffer reference(SampleRate, 1, NumberFrames);
+    std::fill(reference.data(), reference.data() + reference.size(), 2.f);
+    EXPECT_THROW(pipeline.feed(near, reference), std::invalid_argument);
+    EXPECT_THROW(pipeline.feed(far, AudioBuffer(SampleRate / 2, 1, NumberFrames)), std::invalid_argument);
+    pipeline.feed(far, reference);
+    pipeline.process(input);
+    EXPECT_TRUE(std::all_of(result.data(), result.data() + result.size(), [](float x) { return x == 1.f; }));
+}
@@ -0,0 +1,109 @@
+#include <profiler.hpp>
+#include <pipeline.hpp>
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using namespace score;
+
+TEST(ProfilerTest, EstimatesPercentiles) {
+    Profiler profiler(true);
+    const auto probe = profiler.registerBlock("block");
+    for (auto i = 1; i <= 1000; ++i) {
+        profiler.recordTime(probe, i * 1000, i * 500);
+    }
+
+    const auto statistics = profiler.snapshot();
+    ASSERT_EQ(statistics.size(), 1);
+    EXPECT_EQ(statistics[0].name, "block");
+    EXPECT_EQ(statistics[0].frames, 1000);
+    EXPECT_NEAR(statistics[0].wall.p50, 500, 500 * 0.125);
+    EXPECT_NEAR(statistics[0].wall.p99, 990, 990 * 0.125);
+    EXPECT_DOUBLE_EQ(statistics[0].wall.max, 1000);
+    EXPECT_NEAR(statistics[0].cpu.p50, 250, 250 * 0.125);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.snapshot()[0].frames, 0);
+    EXPECT_DOUBLE_EQ(profiler.snapshot()[0].wall.max, 0);
+}
+
+TEST(ProfilerTest, DisabledProfilerDoesNotRecord) {
+    Profiler profiler;
+    const auto probe = profiler.registerBlock("block");
+    profiler.setClock([]() { return 1.0; });
+    {
+        Profiler::Scope scope(profiler, probe);
+    }
+    profiler.recordLatency(probe, 0.5);
+    profiler.recordDropped(probe, 10);
+
+    const auto statistics = profiler.snapshot();
+    EXPECT_EQ(statistics[0].frames, 0);
+    EXPECT_EQ(statistics[0].dropped, 0);
+    EXPECT_DOUBLE_EQ(statistics[0].latency.max, 0);
+}
+
+TEST(ProfilerTest, MeasuresPipelineStages) {
+    auto profiler = std::make_shared<Profiler>(true);
+    profiler->setClock([]() { return 1.010; });
+
+    Pipeline pipeline(16000, 2, 160);
+    pipeline.add("copy", [](const AudioBufferView& input, AudioBuffer& output) {
+        input.copyTo(output);
+    });
+    pipeline.sink("sink", [](const AudioBufferView&) {});
+    pipeline.setProfiler(profiler);
+
+    AudioBuffer input(16000, 2, 160);
+    input.setTimestamp(1.0);
+    for (auto i = 0; i < 10; ++i) {
+        pipeline.process(input);
+    }
+
+    const auto statistics = profiler->snapshot();
+    ASSERT_EQ(statistics.size(), 3);
+    EXPECT_EQ(statistics[0].name, "pipeline");
+    EXPECT_EQ(statistics[1].name, "copy");
+    EXPECT_EQ(statistics[2].name, "sink");
+    for (const auto& block : statistics) {
+        EXPECT_EQ(block.frames, 10);
+    }
+    EXPECT_NEAR(statistics[2].latency.p50, 10000, 10000 * 0.125);
+    EXPECT_DOUBLE_EQ(statistics[1].latency.max, 0);
+
+    const auto json = profiler->toJson();
+    EXPECT_NE(json.find("\"name\": \"copy\""), std::string::npos);
+    EXPECT_NE(json.find("\"latency\""), std::string::npos);
+}
+
+TEST(ProfilerTest, MeasuresLatencyOnTheCaptureClock) {
+    const auto now = []() {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+
+    auto profiler = std::make_shared<Profiler>(true);
+    profiler->setClock(now);
+
+    Pipeline pipeline(16000, 2, 160);
+    pipeline.add("wait", [](const AudioBufferView& input, AudioBuffer& output) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        input.copyTo(output);
+    });
+    pipeline.sink("sink", [](const AudioBufferView&) {});
+    pipeline.setProfiler(profiler);
+    pipeline.setProfiler(profiler);
+
+    // Frames are stamped when captured with the same clock used by the profiler.
+    AudioBuffer input(16000, 2, 160);
+    for (auto i = 0; i < 5; ++i) {
+        input.setTimestamp(now());
+        pipeline.process(input);
+    }
+
+    const auto statistics = profiler->snapshot();
+    ASSERT_EQ(statistics.size(), 3);
+    EXPECT_EQ(statistics[2].frames, 5);
+    EXPECT_GE(statistics[2].latency.p50, 2000 * 0.875);
+    EXPECT_LT(statistics[2].latency.max, 1e6);
+}
@@ -0,0 +1,91 @@
+#include <ring_buffer.hpp>
+
+#include <gtest/gtest.h>
+#include <array>
+#include <numeric>
+#include <thread>
+
+using namespace score;
+
+TEST(RingBufferTest, WriteAndRead) {
+    constexpr auto Capacity = 16ul;
+    RingBuffer<float> buffer(Capacity);
+    EXPECT_EQ(buffer.capacity(), Capacity);
+    EXPECT_TRUE(buffer.empty());
+
+    std::array<float, 10> input{}, output{};
+    std::iota(std::begin(input), std::end(input), 0);
+    EXPECT_TRUE(buffer.write(input.data(), input.size()));
+    EXPECT_EQ(buffer.available(), input.size());
+    EXPECT_EQ(buffer.space(), Capacity - input.size());
+
+    EXPECT_TRUE(buffer.read(output.data(), output.size()));
+    EXPECT_TRUE(std::equal(std::begin(input), std::end(input), std::begin(output)));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, WrapAround) {
+    RingBuffer<int> buffer(8);
+    std::array<int, 6> input{}, output{};
+    for (auto i = 0; i < 10; ++i) {
+        std::iota(std::begin(input), std::end(input), i * 6);
+        ASSERT_TRUE(buffer.write(input.data(), input.size()));
+        ASSERT_TRUE(buffer.read(output.data(), output.size()));
+        EXPECT_TRUE(std::equal(std::begin(input), std::end(input), std::begin(output)));
+    }
+}
+
+TEST(RingBufferTest, Overflow) {
+    RingBuffer<int> buffer(8);
+    std::array<int, 6> data{};
+    EXPECT_TRUE(buffer.write(data.data(), data.size()));
+    EXPECT_FALSE(buffer.write(data.data(), data.size()));
+    EXPECT_EQ(buffer.available(), data.size());
+    EXPECT_TRUE(buffer.discard(data.size()));
+    EXPECT_FALSE(buffer.read(data.data(), 1));
+}
+
+TEST(RingBufferTest, Rewind) {
+    RingBuffer<int> buffer(8);
+    std::array<int, 6> input{}, output{};
+    EXPECT_FALSE(buffer.rewind(1));
+    std::iota(std::begin(input), std::end(input), 0);
+    EXPECT_TRUE(buffer.write(input.data(), input.size()));
+    EXPECT_TRUE(buffer.read(output.data(), 4));
+
+    // The consumed elements are still there until the producer overwrites them.
+    EXPECT_TRUE(buffer.rewind(3));
+    EXPECT_EQ(buffer.available(), 5ul);
+    EXPECT_TRUE(buffer.read(output.data(), 5));
+    EXPECT_TRUE(std::equal(std::begin(input) + 1, std::end(input), std::begin(output)));
+    EXPECT_TRUE(buffer.write(input.data(), input.size()));
+    EXPECT_FALSE(buffer.rewind(3));
+    EXPECT_TRUE(buffer.rewind(2));
+    EXPECT_EQ(buffer.available(), 8ul);
+}
+
+TEST(RingBufferTest, ProducerConsumer) {
+    constexpr auto Blocks = 10000;
+    constexpr auto BlockSize = 32;
+    RingBuffer<int> buffer(4 * BlockSize);
+
+    std::thread producer([&]() {
+        std::array<int, BlockSize> block{};
+        for (auto i = 0; i < Blocks; ++i) {
+            std::fill(std::begin(block), std::end(block), i);
+            while (!buffer.write(block.data(), block.size())) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::array<int, BlockSize> block{};
+    for (auto i = 0; i < Blocks; ++i) {
+        while (!buffer.read(block.data(), block.size())) {
+            std::this_thread::yield();
+        }
+        ASSERT_TRUE(std::all_of(std::begin(block), std::end(block), [i](int value) { return value == i; }));
+    }
+    producer.join();
+    EXPECT_TRUE(buffer.empty());
+}
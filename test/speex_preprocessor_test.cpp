@@ -0,0 +1,108 @@
+#include <speex_preprocessor.hpp>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace score;
+
+namespace {
+
+    constexpr std::int32_t SampleRate = 16000;
+    constexpr std::size_t FrameSize = 160;
+
+    float energy(const AudioBuffer& buffer) {
+        auto sum = 0.0f;
+        for (auto i = 0ul; i < buffer.size(); ++i) {
+            sum += buffer.data()[i] * buffer.data()[i];
+        }
+        return sum;
+    }
+
+}
+
+TEST(SpeexPreprocessorTest, CombinesTheFeaturesInOneBlock) {
+    EXPECT_THROW(SpeexPreprocessor(SampleRate, 0, FrameSize), std::invalid_argument);
+    EXPECT_THROW(SpeexPreprocessor(SampleRate, 2, 480), std::invalid_argument);
+    EXPECT_THROW(SpeexPreprocessor(SampleRate, 2, FrameSize, 1 << 4), std::invalid_argument);
+
+    const auto features = SpeexPreprocessor::Denoise | SpeexPreprocessor::DeReverb
+                          | SpeexPreprocessor::EchoSuppression | SpeexPreprocessor::VoiceDetection;
+    SpeexPreprocessor preprocessor(SampleRate, 2, FrameSize, features);
+    EXPECT_EQ(preprocessor.features(), features);
+
+    AudioBuffer input(SampleRate, 2, FrameSize), output;
+    EXPECT_THROW(preprocessor.process(input, output), std::runtime_error);
+
+    // The residual echo is estimated by a Speex canceller with a reference per channel.
+    EXPECT_THROW(preprocessor.setEchoCanceller(AEC(SampleRate, 2, FrameSize, 1600, AEC::WebRTCAEC3)),
+                 std::invalid_argument);
+    EXPECT_THROW(preprocessor.setEchoCanceller(AEC::MultiReference(SampleRate, 2, 1, FrameSize, 1600)),
+                 std::invalid_argument);
+    EXPECT_THROW(preprocessor.setEchoCanceller(AEC(SampleRate, 3, FrameSize, 1600)), std::invalid_argument);
+    EXPECT_THROW(preprocessor.setEchoCanceller(AEC(SampleRate, 2, 2 * FrameSize, 1600)), std::invalid_argument);
+    EXPECT_THROW(preprocessor.setEchoCanceller(AEC(SampleRate / 2, 2, FrameSize / 2, 800)), std::invalid_argument);
+
+    AEC aec(SampleRate, 2, FrameSize, 1600);
+    preprocessor.setEchoCanceller(aec);
+    aec.process(input, input, output);
+    preprocessor.process(output, output);
+    EXPECT_EQ(output.channels(), 2);
+    EXPECT_EQ(output.framesPerChannel(), FrameSize);
+    EXPECT_NO_THROW(preprocessor.isVoice(1));
+    EXPECT_THROW(preprocessor.isVoice(2), std::invalid_argument);
+    EXPECT_THROW(SpeexPreprocessor(SampleRate, 2, FrameSize).isVoice(), std::runtime_error);
+}
+
+TEST(SpeexPreprocessorTest, DenoiseReducesStationaryNoise) {
+    std::mt19937 generator(7);
+    std::normal_distribution<float> noise(0.0f, 1000.0f);
+
+    SpeexPreprocessor preprocessor(SampleRate, 1, FrameSize, SpeexPreprocessor::Denoise);
+    AudioBuffer input(SampleRate, 1, FrameSize), output;
+    auto input_energy = 0.0f, output_energy = 0.0f;
+    for (auto frame = 0; frame < 300; ++frame) {
+        std::generate(input.data(), input.data() + input.size(), [&]() { return noise(generator); });
+        preprocessor.process(input, output);
+
+        // The noise estimate needs a few frames to converge.
+        if (frame >= 200) {
+            input_energy += energy(input);
+            output_energy += energy(output);
+        }
+    }
+    EXPECT_LT(output_energy, 0.25f * input_energy);
+}
+
+TEST(SpeexPreprocessorTest, DetectsVoiceFrames) {
+    std::mt19937 generator(7);
+    std::normal_distribution<float> noise(0.0f, 30.0f);
+
+    SpeexPreprocessor preprocessor(SampleRate, 1, FrameSize,
+                                   SpeexPreprocessor::Denoise | SpeexPreprocessor::VoiceDetection);
+    AudioBuffer input(SampleRate, 1, FrameSize), output;
+
+    // Background noise only: the frames are not flagged once the noise is estimated.
+    auto voice_frames = 0;
+    for (auto frame = 0; frame < 200; ++frame) {
+        std::generate(input.data(), input.data() + input.size(), [&]() { return noise(generator); });
+        preprocessor.process(input, output);
+        voice_frames += frame >= 100 && preprocessor.isVoice();
+    }
+    EXPECT_LE(voice_frames, 20);
+
+    // Voiced sound, a harmonic series with a pitch of 200 Hz, on top of the same noise.
+    voice_frames = 0;
+    for (auto frame = 0, n = 0; frame < 30; ++frame) {
+        for (auto j = 0ul; j < FrameSize; ++j, ++n) {
+            auto sample = noise(generator);
+            for (auto harmonic = 1; harmonic <= 10; ++harmonic) {
+                sample += 3000.0f / harmonic * std::sin(2 * M_PI * 200 * harmonic * n / SampleRate);
+            }
+            input.channel(0)[j] = sample;
+        }
+        preprocessor.process(input, output);
+        voice_frames += preprocessor.isVoice();
+    }
+    EXPECT_GE(voice_frames, 20);
+}
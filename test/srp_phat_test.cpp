@@ -0,0 +1,80 @@
+#include <srp_phat.hpp>
+#include <array_geometry.hpp>
+
+#include "testing_utils.hpp"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+constexpr std::size_t SamplesPerChannel = 512;
+constexpr float SoundSpeed = 343.2f;
+
+// Simulates a far-field source by delaying white noise with a windowed sinc interpolator.
+static AudioBuffer FarFieldNoise(const std::vector<Point<float>>& microphones, float azimuth, float elevation) {
+    constexpr auto Taps = 32;
+    std::mt19937 generator(3);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    std::vector<float> noise(SamplesPerChannel + 4 * Taps);
+    std::generate(noise.begin(), noise.end(), [&]() { return distribution(generator); });
+
+    const auto az = azimuth * M_PI / 180.0;
+    const auto el = elevation * M_PI / 180.0;
+    const Point<float> direction = {std::cos(el) * std::cos(az), std::cos(el) * std::sin(az), std::sin(el)};
+
+    AudioBuffer buffer(SampleRate, static_cast<std::int8_t>(microphones.size()), SamplesPerChannel);
+    for (auto m = 0ul; m < microphones.size(); ++m) {
+        const auto advance = (microphones[m][0] * direction[0] + microphones[m][1] * direction[1]
+                              + microphones[m][2] * direction[2]) * SampleRate / SoundSpeed;
+        for (auto n = 0ul; n < SamplesPerChannel; ++n) {
+            const auto position = static_cast<double>(n + 2 * Taps) + advance;
+            const auto base = static_cast<long>(std::floor(position));
+            auto sample = 0.0;
+            for (auto k = base - Taps + 1; k <= base + Taps; ++k) {
+                const auto x = position - k;
+                const auto sinc = std::abs(x) < 1e-9 ? 1.0 : std::sin(M_PI * x) / (M_PI * x);
+                const auto window = 0.5 + 0.5 * std::cos(M_PI * x / Taps);
+                sample += noise[k] * sinc * window;
+            }
+            buffer.channel(m)[n] = static_cast<float>(sample);
+        }
+    }
+    return buffer;
+}
+
+TEST(SrpPhatTest, LocalizesSourceInThePlane) {
+    const auto microphones = ArrayGeometry::Circular(6, 0.0463).microphones();
+    SrpPhat srp(SampleRate, SamplesPerChannel, microphones, SoundSpeed);
+    EXPECT_EQ(srp.coarseDirections(), 36);
+    EXPECT_EQ(srp.fineDirections(), 360);
+
+    for (const auto azimuth : {0.0f, 47.0f, 135.0f, 212.0f, 359.0f}) {
+        const auto direction = srp.process(FarFieldNoise(microphones, azimuth, 0));
+        EXPECT_LE(AngularError(direction.azimuth, azimuth), 3.0f) << "Azimuth: " << azimuth;
+        EXPECT_FLOAT_EQ(direction.elevation, 0);
+        EXPECT_GT(direction.power, 0);
+    }
+}
+
+TEST(SrpPhatTest, SearchesTheElevation) {
+    auto microphones = ArrayGeometry::Circular(6, 0.0463).microphones();
+    microphones.push_back({0, 0, 0.08});
+    SrpPhat srp(SampleRate, SamplesPerChannel, microphones, SoundSpeed);
+    srp.setResolution(15, 3);
+    srp.setElevationRange(-60, 60);
+
+    const auto direction = srp.process(FarFieldNoise(microphones, 100, 30));
+    EXPECT_LE(AngularError(direction.azimuth, 100), 9.0f);
+    EXPECT_NEAR(direction.elevation, 30, 9.0f);
+}
+
+TEST(SrpPhatTest, RejectsInvalidConfigurations) {
+    EXPECT_THROW(SrpPhat(SampleRate, SamplesPerChannel, ArrayGeometry::Circular(1, 0.05).microphones()),
+                 std::invalid_argument);
+    SrpPhat srp(SampleRate, SamplesPerChannel, ArrayGeometry::Circular(4, 0.05).microphones());
+    EXPECT_THROW(srp.setResolution(1, 10), std::invalid_argument);
+    EXPECT_THROW(srp.setElevationRange(-100, 0), std::invalid_argument);
+}
@@ -0,0 +1,79 @@
+#include <stft.hpp>
+
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace score;
+
+constexpr std::int32_t SampleRate = 16000;
+
+// Analyses and synthesizes a stream of white noise, checking that the output is the input delayed by the latency.
+static void ExpectReconstruction(STFT& stft, std::int8_t channels, std::size_t hops) {
+    std::mt19937 generator(29);
+    std::normal_distribution<float> distribution(0.0f, 1.0f);
+    const auto hop = stft.hopSize();
+    std::vector<float> signal(static_cast<std::size_t>(channels) * hops * hop);
+    std::generate(signal.begin(), signal.end(), [&]() { return distribution(generator); });
+
+    AudioBuffer input(SampleRate, channels, hop), output;
+    for (auto h = 0ul; h < hops; ++h) {
+        for (auto i = 0; i < channels; ++i) {
+            std::copy_n(signal.data() + (i * hops + h) * hop, hop, input.channel(i));
+        }
+        stft.analyze(input);
+        stft.synthesize(output);
+        ASSERT_EQ(output.channels(), channels);
+        ASSERT_EQ(output.framesPerChannel(), hop);
+
+        for (auto i = 0; i < channels; ++i) {
+            for (auto n = 0ul; n < hop; ++n) {
+                const auto time = h * hop + n;
+                const auto expected = time < stft.latency() ? 0.0f : signal[i * hops * hop + time - stft.latency()];
+                ASSERT_NEAR(output.channel(i)[n], expected, 1e-4) << "Hop: " << h << " Channel: " << i;
+            }
+        }
+    }
+}
+
+TEST(STFTTest, ReconstructsAtHalfOverlap) {
+    STFT stft(4, 512, 256);
+    EXPECT_EQ(stft.bins(), 257);
+    EXPECT_EQ(stft.latency(), 256);
+    ExpectReconstruction(stft, 4, 20);
+}
+
+TEST(STFTTest, ReconstructsWithOtherWindowsAndPadding) {
+    STFT hann(2, 256, 64, 512, STFT::Hann);
+    ExpectReconstruction(hann, 2, 30);
+    STFT hamming(1, 200, 80, 0, STFT::Hamming);
+    ExpectReconstruction(hamming, 1, 30);
+    STFT rectangular(1, 128, 128, 256, STFT::Rectangular);
+    ExpectReconstruction(rectangular, 1, 10);
+}
+
+TEST(STFTTest, SynthesizesModifiedSpectra) {
+    // The sum of the spectra of a tone and of a silent channel, synthesized with the overlap of the first channel.
+    STFT stft(2, 256, 128);
+    AudioBuffer input(SampleRate, 2, 128), output;
+    Matrix<std::complex<float>> spectra(1, static_cast<Eigen::Index>(stft.bins()));
+    for (auto h = 0ul; h < 10; ++h) {
+        for (auto n = 0ul; n < 128; ++n) {
+            const auto time = static_cast<double>(h * 128 + n);
+            input.channel(0)[n] = static_cast<float>(std::sin(2 * M_PI * 1000 * time / SampleRate));
+            input.channel(1)[n] = 0.0f;
+        }
+        spectra.row(0) = stft.analyze(input).row(0) + stft.spectra().row(1);
+        stft.synthesize(spectra, output);
+        ASSERT_EQ(output.channels(), 1);
+        if (h > 0) {
+            for (auto n = 0ul; n < 128; ++n) {
+                const auto time = static_cast<double>(h * 128 + n - stft.latency());
+                ASSERT_NEAR(output.data()[n], std::sin(2 * M_PI * 1000 * time / SampleRate), 1e-4);
+            }
+        }
+    }
+
+    EXPECT_THROW(STFT(2, 256, 512), std::invalid_argument);
+    EXPECT_THROW(STFT(2, 256, 128, 128), std::invalid_argument);
+    EXPECT_THROW(stft.analyze(AudioBuffer(SampleRate, 2, 64)), std::invalid_argument);
+}
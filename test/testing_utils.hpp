@@ -0,0 +1,22 @@
+#ifndef SMARTCORE_TESTING_UTILS_HPP
+#define SMARTCORE_TESTING_UTILS_HPP
+
+#include <algorithm>
+#include <cmath>
+
+namespace score {
+
+    /**
+     * @brief Returns the angular distance between two azimuths, taking into account the wrap around 360 degrees.
+     * @param estimated Estimated azimuth in degrees.
+     * @param expected Expected azimuth in degrees.
+     * @return Distance in degrees, between 0 and 180.
+     */
+    inline float AngularError(float estimated, float expected) {
+        const auto error = std::fmod(std::abs(estimated - expected), 360.0f);
+        return std::min(error, 360.0f - error);
+    }
+
+}
+
+#endif //SMARTCORE_TESTING_UTILS_HPP
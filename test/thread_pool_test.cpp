@@ -0,0 +1,41 @@
+#include <thread_pool.hpp>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+using namespace score;
+
+TEST(ThreadPoolTest, RunsEveryTaskOnce) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.size(), 4);
+
+    std::vector<int> counters(8, 0);
+    for (auto i = 0; i < 1000; ++i) {
+        pool.parallelFor(counters.size(), [&counters](std::size_t index) {
+            ++counters[index];
+        });
+    }
+    EXPECT_TRUE(std::all_of(counters.begin(), counters.end(), [](int value) { return value == 1000; }));
+}
+
+TEST(ThreadPoolTest, PropagatesExceptions) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.parallelFor(8, [](std::size_t index) {
+        if (index == 5) {
+            throw std::runtime_error("Task failed");
+        }
+    }), std::runtime_error);
+}
+
+TEST(ThreadPoolTest, NestedJobsRunSerially) {
+    ThreadPool pool(4);
+    std::vector<int> counters(4, 0);
+    pool.parallelFor(counters.size(), [&](std::size_t index) {
+        pool.parallelFor(3, [&](std::size_t) {
+            ++counters[index];
+        });
+    });
+    EXPECT_TRUE(std::all_of(counters.begin(), counters.end(), [](int value) { return value == 3; }));
+}